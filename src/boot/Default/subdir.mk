@@ -1,31 +0,0 @@
-################################################################################
-# Automatically-generated file. Do not edit!
-################################################################################
-
-# Add inputs and outputs from these tool invocations to the build variables 
-C_SRCS += \
-../uefiboot.c 
-
-C_DEPS += \
-./uefiboot.d 
-
-OBJS += \
-./uefiboot.o 
-
-
-# Each subdirectory must supply rules for building sources it contributes
-%.o: ../%.c subdir.mk
-	@echo 'Building file: $<'
-	@echo 'Invoking: GCC C Compiler'
-	gcc -O2 -g -Wall -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -o "$@" "$<"
-	@echo 'Finished building: $<'
-	@echo ' '
-
-
-clean: clean--2e-
-
-clean--2e-:
-	-$(RM) ./uefiboot.d ./uefiboot.o
-
-.PHONY: clean--2e-
-
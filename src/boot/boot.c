@@ -6,7 +6,7 @@
 // Project     : Shasta Microkernel                                                                         //
 // Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
 // Created     : August 27, 2023                                                                            //
-// Modified    : August 27, 2023                                                                            //
+// Modified    : October 19, 2026                                                                           //
 // Version     : 0.0.0                                                                                      //
 // License     : GNU General Public License (GPL) version 3.0                                               //
 // Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
@@ -32,15 +32,48 @@
 #include <stdarg.h>
 #include <stdbool.h>
 
+#include "bootlog.h"
+#include "bootstage.h"
+#include "loader.h"
 #include "uefiutil.h"
 
-EFI_STATUS EFIAPI efi_main (EFI_HANDLE ImageHandle, EFI_SYSTEM_TABLE *SystemTable) {
+static CHAR16 *KernelSourceNames[] = {
+    [KernelSourceBootVolume] = L"boot volume",
+    [KernelSourceCache]      = L"cached",
+    [KernelSourceSearch]     = L"full lookup",
+};
+
+// gnu-efi's crt0 receives the firmware's MS ABI call and calls efi_main with the native (System V)
+// convention, so efi_main itself must not be declared EFIAPI.
+EFI_STATUS efi_main (EFI_HANDLE ImageHandle, EFI_SYSTEM_TABLE *SystemTable) {
     EFI_STATUS Status;
     EFI_INPUT_KEY Key;
     EFI_SYSTEM_TABLE *ST = SystemTable;
-    InitializeLib(ImageHandle, SystemTable);
+    struct KernelImage Kernel;
+    BootStage("entry");
+    UefiInitializeLib(ImageHandle, SystemTable);
+    BootLogInitialize();
+    BootLog("boot: efi_main entered\r\n");
     Print(L"Hello, world!\r\n");
 
+    Status = LoadKernel(ImageHandle, SystemTable, &Kernel);
+    BootStage("loaded");
+    if (EFI_ERROR(Status)) {
+        Print(L"Unable to load kernel %s (status %lx)\r\n", KERNEL_PATH, (UINT64)Status);
+        BootLogFlush();
+    }
+    else {
+        Print(L"Loaded kernel (%lu bytes, %s)\r\n", (UINT64)Kernel.Size, KernelSourceNames[Kernel.Source]);
+    }
+
+    // The log is only written out by a SAVE_BOOT_LOG=1 build, and then only if the file already exists on the
+    // boot volume; see BootLogSave.
+    BootLogSave(ImageHandle, SystemTable, BOOT_LOG_PATH);
+
+    // Everything up to here is what the kernel will wait for once the handoff is implemented.
+    BootStage("handoff");
+    BootStageCalibrate(ST->BootServices);
+
     Status = ST->ConIn->Reset(ST->ConIn, FALSE);
     if (EFI_ERROR(Status))
         return Status;
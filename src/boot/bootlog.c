@@ -0,0 +1,275 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Implementation File, Deferred Boot Log                                                     //
+// Filename    : bootlog.c                                                                                  //
+// Description : Implements the deferred boot log: rendering of pending records to the console, export of   //
+//               the log as a self-contained image with its strings, and rendering of exported images.      //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include "bootlog.h"
+#include "uefiutil.h"
+
+UINT64  BootLogBuffer[BOOT_LOG_WORDS];
+UINTN   BootLogHead;
+UINT32  BootLogDropped;
+bool    BootLogConsole;
+
+static UINTN   BootLogRendered;
+static UINT32  BootLogDroppedReported;
+static UINT64  BootLogBase;
+
+/// @brief Recovers the format string address from a record descriptor word.
+static inline const VOID *RecordFormat(UINT64 Descriptor)
+{
+    return (const VOID *)(UINTN)((INT64)(Descriptor << (64 - BOOT_LOG_COUNT_SHIFT)) >>
+                                 (64 - BOOT_LOG_COUNT_SHIFT));
+}
+
+/// @brief Empties the log and takes the current timestamp as the origin of the timestamps reported for it.
+void BootLogInitialize(void)
+{
+    BootLogHead = 0;
+    BootLogDropped = 0;
+    BootLogRendered = 0;
+    BootLogDroppedReported = 0;
+    BootLogBase = ReadTimestamp();
+}
+
+/// @brief Attaches or detaches the console. While attached, every record is rendered as soon as it is
+///        written; attaching renders any records still pending. The console must be detached before
+///        `ExitBootServices` is called.
+/// @param Attach whether records should be rendered to the console as they are written
+void BootLogAttachConsole(bool Attach)
+{
+    BootLogConsole = Attach;
+    if (Attach)
+        BootLogFlush();
+}
+
+/// @brief Renders every record not yet rendered to the console, each prefixed with its timestamp (in ticks
+///        since `BootLogInitialize`), followed by a note of any records dropped since the last flush.
+void BootLogFlush(void)
+{
+    while (BootLogRendered < BootLogHead) {
+        UINT64 *record = &BootLogBuffer[BootLogRendered];
+        UINT64 descriptor = record[1];
+        UINTN count = BootLogRecordCount(descriptor);
+
+        PrintNarrow("[%12lu] ", record[0] - BootLogBase);
+        PrintRecord(RecordFormat(descriptor), (descriptor & BOOT_LOG_WIDE) != 0,
+                    record + BOOT_LOG_HEADER_WORDS, count);
+        BootLogRendered += BOOT_LOG_HEADER_WORDS + count;
+    }
+
+    if (BootLogDropped != BootLogDroppedReported) {
+        PrintNarrow("[bootlog] %u record(s) dropped\r\n", BootLogDropped - BootLogDroppedReported);
+        BootLogDroppedReported = BootLogDropped;
+    }
+}
+
+#ifdef BOOT_LOG_SAVE
+
+// A string referenced by the log, interned during export.
+struct BootLogString {
+    const VOID *Pointer;
+    bool        IsWide;
+    UINT32      Offset;
+    UINT32      Length;
+};
+
+static UINT64               BootLogTicksPerSecond;
+static struct BootLogString BootLogStrings[BOOT_LOG_MAX_STRINGS];
+static UINTN                BootLogStringCount;
+
+/// @brief Interns a string for export, returning its offset in the string table. Strings are identified by
+///        address and width; the same literal logged many times is stored once.
+/// @param String the string to intern, or `NULL`
+/// @param IsWide whether `String` is a CHAR16 string
+/// @param Bytes  the running size of the string table, updated if the string is added
+/// @return       the offset of the string, or `BOOT_LOG_NO_STRING` if it is `NULL` or the table is full
+static UINT64 InternString(const VOID *String, bool IsWide, UINT32 *Bytes)
+{
+    if (String == NULL)
+        return BOOT_LOG_NO_STRING;
+
+    for (UINTN i = 0; i < BootLogStringCount; i++) {
+        if (BootLogStrings[i].Pointer == String && BootLogStrings[i].IsWide == IsWide)
+            return BootLogStrings[i].Offset;
+    }
+    if (BootLogStringCount == BOOT_LOG_MAX_STRINGS)
+        return BOOT_LOG_NO_STRING;
+
+    UINT32 length = 0;
+    if (IsWide) {
+        while (length < BOOT_LOG_MAX_STRING_LENGTH && ((const CHAR16 *)String)[length] != 0)
+            length++;
+    }
+    else {
+        while (length < BOOT_LOG_MAX_STRING_LENGTH && ((const char *)String)[length] != 0)
+            length++;
+    }
+
+    struct BootLogString *entry = &BootLogStrings[BootLogStringCount++];
+    entry->Pointer = String;
+    entry->IsWide = IsWide;
+    entry->Offset = (*Bytes + 1) & ~1U;
+    entry->Length = length;
+    *Bytes = entry->Offset + (length + 1) * (IsWide ? sizeof(CHAR16) : sizeof(char));
+    return entry->Offset;
+}
+
+/// @brief Walks the records of the log, interning (and, when `Records` is set, rewriting) the format string
+///        and string arguments of each. Used twice by `BootLogExport`: once to size the image and once to
+///        fill it.
+/// @param Records the destination for the rewritten records, or `NULL` to only intern the strings
+/// @param Bytes   the running size of the string table
+static void ExportRecords(UINT64 *Records, UINT32 *Bytes)
+{
+    char kinds[BOOT_LOG_MAX_ARGS];
+
+    for (UINTN index = 0; index < BootLogHead;) {
+        const UINT64 *record = &BootLogBuffer[index];
+        UINT64 descriptor = record[1];
+        UINTN count = BootLogRecordCount(descriptor);
+        bool isWide = (descriptor & BOOT_LOG_WIDE) != 0;
+        const VOID *format = RecordFormat(descriptor);
+
+        UINT64 offset = InternString(format, isWide, Bytes);
+        size_t used = ClassifyArguments(format, isWide, kinds, BOOT_LOG_MAX_ARGS);
+        if (Records != NULL) {
+            Records[index] = record[0];
+            Records[index + 1] = (descriptor & ~BOOT_LOG_ADDRESS_MASK) | (offset & BOOT_LOG_ADDRESS_MASK);
+        }
+
+        for (UINTN i = 0; i < count; i++) {
+            UINT64 word = record[BOOT_LOG_HEADER_WORDS + i];
+            if (i < used && i < BOOT_LOG_MAX_ARGS && (kinds[i] == 's' || kinds[i] == 'S'))
+                word = InternString((const VOID *)(UINTN)word, kinds[i] == 'S', Bytes);
+            if (Records != NULL)
+                Records[index + BOOT_LOG_HEADER_WORDS + i] = word;
+        }
+        index += BOOT_LOG_HEADER_WORDS + count;
+    }
+}
+
+/// @brief Exports the log as a self-contained `BootLogImage`, which carries copies of every string the
+///        records refer to and can therefore be rendered by a host-side decoder.
+/// @param Image receives the image, allocated with `UefiAllocatePool`
+/// @param Size  receives the size of the image in bytes
+/// @return      an `EFI_STATUS` indicating the result of the operation
+EFI_STATUS BootLogExport(VOID **Image, UINTN *Size)
+{
+    UINT32 bytes = 0;
+
+    BootLogStringCount = 0;
+    ExportRecords(NULL, &bytes);
+
+    UINTN recordBytes = BootLogHead * sizeof(UINT64);
+    *Size = sizeof(struct BootLogImage) + recordBytes + bytes;
+    EFI_STATUS status = UefiAllocatePool(EfiLoaderData, *Size, Image);
+    if (EFI_ERROR(status))
+        return status;
+
+    struct BootLogImage *header = *Image;
+    UINT64 *records = (UINT64 *)(header + 1);
+    UINT8 *strings = (UINT8 *)records + recordBytes;
+
+    *header = (struct BootLogImage){
+        .Signature = BOOT_LOG_SIGNATURE,
+        .Version = BOOT_LOG_VERSION,
+        .HeaderSize = sizeof(struct BootLogImage),
+        .BaseTimestamp = BootLogBase,
+        .TicksPerSecond = BootLogTicksPerSecond,
+        .RecordWords = (UINT32)BootLogHead,
+        .StringBytes = bytes,
+        .Dropped = BootLogDropped,
+    };
+
+    // The strings were interned by the sizing pass, so this pass finds them all again at the same offsets.
+    bytes = 0;
+    ExportRecords(records, &bytes);
+
+    for (UINTN i = 0; i < header->StringBytes; i++)
+        strings[i] = 0;
+    for (UINTN i = 0; i < BootLogStringCount; i++) {
+        struct BootLogString *entry = &BootLogStrings[i];
+        UINTN length = entry->Length * (entry->IsWide ? sizeof(CHAR16) : sizeof(char));
+        __builtin_memcpy(strings + entry->Offset, entry->Pointer, length);
+    }
+    return EFI_SUCCESS;
+}
+
+/// @brief Exports the log and writes it to `Path` on the volume the bootloader was loaded from. Even when
+///        compiled in, the file is only replaced if it already exists, so that an unattended boot performs
+///        no writes to the EFI system partition. The timestamp counter is calibrated against `Stall` first so
+///        that the decoder can report times in seconds.
+/// @param ImageHandle the `EFI_HANDLE` passed to `efi_main`
+/// @param SystemTable the `EFI_SYSTEM_TABLE` passed to `efi_main`
+/// @param Path        the path of the log file on the boot volume
+/// @return            `EFI_NOT_FOUND` if the file does not exist, otherwise the result of the operation
+EFI_STATUS BootLogSave(EFI_HANDLE ImageHandle, EFI_SYSTEM_TABLE *SystemTable, CHAR16 *Path)
+{
+    EFI_GUID loadedImageGuid = EFI_LOADED_IMAGE_PROTOCOL_GUID;
+    EFI_GUID fileSystemGuid = EFI_SIMPLE_FILE_SYSTEM_PROTOCOL_GUID;
+    EFI_BOOT_SERVICES *BS = SystemTable->BootServices;
+    EFI_LOADED_IMAGE *loadedImage;
+    EFI_SIMPLE_FILE_SYSTEM_PROTOCOL *fs;
+    EFI_FILE_HANDLE root, file;
+
+    EFI_STATUS status = BS->HandleProtocol(ImageHandle, &loadedImageGuid, (VOID **)&loadedImage);
+    if (EFI_ERROR(status))
+        return status;
+    status = BS->HandleProtocol(loadedImage->DeviceHandle, &fileSystemGuid, (VOID **)&fs);
+    if (EFI_ERROR(status))
+        return status;
+    status = fs->OpenVolume(fs, &root);
+    if (EFI_ERROR(status))
+        return status;
+
+    // Replace the existing file rather than overwriting it in place, so that no stale tail remains.
+    status = root->Open(root, &file, Path, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE, 0);
+    if (!EFI_ERROR(status)) {
+        file->Delete(file);
+        status = root->Open(root, &file, Path,
+                            EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_CREATE, 0);
+    }
+    root->Close(root);
+    if (EFI_ERROR(status))
+        return status;
+
+    UINT64 start = ReadTimestamp();
+    BS->Stall(1000);
+    BootLogTicksPerSecond = (ReadTimestamp() - start) * 1000;
+
+    VOID *image;
+    UINTN size;
+    status = BootLogExport(&image, &size);
+    if (!EFI_ERROR(status)) {
+        status = file->Write(file, &size, image);
+        UefiFreePool(image);
+    }
+    file->Close(file);
+    return status;
+}
+
+#endif /* BOOT_LOG_SAVE */
@@ -0,0 +1,179 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Header File, Deferred Boot Log                                                             //
+// Filename    : bootlog.h                                                                                  //
+// Description : Provides a binary log in which each call site stores only a timestamp, a pointer to its    //
+//               format string and its raw arguments. Records are formatted later: when a console is        //
+//               attached, on demand, or by a host-side decoder working from an exported image of the log.  //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <efi.h>
+#include <efilib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef BOOT_LOG_H
+#define BOOT_LOG_H
+
+#define BOOT_LOG_WORDS              4096            // 32 KiB of records
+#define BOOT_LOG_HEADER_WORDS       2
+#define BOOT_LOG_MAX_ARGS           8
+#define BOOT_LOG_MAX_STRINGS        256
+#define BOOT_LOG_MAX_STRING_LENGTH  1024
+#define BOOT_LOG_ADDRESS_MASK       0x0000FFFFFFFFFFFFULL
+#define BOOT_LOG_COUNT_SHIFT        48
+#define BOOT_LOG_WIDE               0x8000000000000000ULL
+#define BOOT_LOG_NO_STRING          0xFFFFFFFFFFFFFFFFULL
+#define BOOT_LOG_SIGNATURE          0x474F4C53      // 'SLOG'
+#define BOOT_LOG_VERSION            1
+#define BOOT_LOG_PATH               L"\\shasta\\bootlog.bin"
+
+// Each record is `BOOT_LOG_HEADER_WORDS` words followed by its arguments, one word each:
+//
+//      word 0      timestamp counter value
+//      word 1      bits  0-47: format string address (sign-extended from bit 47 when decoded)
+//                  bits 48-55: number of argument words
+//                  bit     63: set if the format string is CHAR16 (`BOOT_LOG_WIDE`)
+//      word 2..    arguments
+//
+// Arguments are stored as they would be passed to `Print`: integers and pointers are converted to 64 bits and
+// floating-point values are stored as the bits of a `double`. A 128-bit argument for a `q` specifier must be
+// passed as two arguments, low half first.
+
+// Header of an exported log. The record words follow, then a table of the strings they refer to. In exported
+// records the format address field and the words of string arguments hold offsets into the string table (or
+// `BOOT_LOG_NO_STRING`) instead of pointers, so that the image can be rendered away from the machine which
+// produced it. Strings keep their original width and are aligned to two bytes.
+struct BootLogImage {
+    UINT32 Signature;
+    UINT16 Version;
+    UINT16 HeaderSize;
+    UINT64 BaseTimestamp;
+    UINT64 TicksPerSecond;
+    UINT32 RecordWords;
+    UINT32 StringBytes;
+    UINT32 Dropped;
+    UINT32 Reserved;
+};
+
+extern UINT64   BootLogBuffer[BOOT_LOG_WORDS];
+extern UINTN    BootLogHead;
+extern UINT32   BootLogDropped;
+extern bool     BootLogConsole;
+
+void        BootLogInitialize       (void);
+void        BootLogAttachConsole    (bool);
+void        BootLogFlush            (void);
+
+// Exporting the log and writing it to the boot volume are only compiled in when `BOOT_LOG_SAVE` is defined
+// (by `make SAVE_BOOT_LOG=1`, and always in the simulator and the boot log tests); otherwise `BootLogSave`
+// costs nothing, in code or in data.
+#ifdef BOOT_LOG_SAVE
+EFI_STATUS  BootLogExport           (VOID **, UINTN *);
+EFI_STATUS  BootLogSave             (EFI_HANDLE, EFI_SYSTEM_TABLE *, CHAR16 *);
+#else
+#define     BootLogSave(ImageHandle, SystemTable, Path)     ((void)0)
+#endif
+
+/// @brief Reads the timestamp counter used to stamp log records.
+static inline UINT64 ReadTimestamp(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+
+/// @brief Returns the number of argument words recorded in a record descriptor word.
+static inline UINTN BootLogRecordCount(UINT64 Descriptor)
+{
+    return (UINTN)((Descriptor >> BOOT_LOG_COUNT_SHIFT) & 0xFF);
+}
+
+static inline UINT64 BootLogIntegerBits(UINT64 Value)
+{
+    return Value;
+}
+
+static inline UINT64 BootLogDoubleBits(double Value)
+{
+    union { double Value; UINT64 Word; } bits = { Value };
+    return bits.Word;
+}
+
+/// @brief Appends a record to the log. This is the whole cost of a `BootLog` call while no console is
+///        attached: a bounds check and `BOOT_LOG_HEADER_WORDS + Count` stores. Records which do not fit are
+///        counted in `BootLogDropped` and discarded.
+/// @param Format the format string, which must remain valid until the record is rendered or exported
+/// @param Flags  `BOOT_LOG_WIDE` if `Format` is a CHAR16 string, zero otherwise
+/// @param Count  the number of argument words
+/// @param Args   the argument words
+static inline void BootLogWrite(const VOID *Format, UINT64 Flags, UINTN Count, const UINT64 *Args)
+{
+    UINTN head = BootLogHead;
+    if (head + BOOT_LOG_HEADER_WORDS + Count > BOOT_LOG_WORDS) {
+        BootLogDropped++;
+        return;
+    }
+
+    BootLogBuffer[head] = ReadTimestamp();
+    BootLogBuffer[head + 1] = ((UINT64)(UINTN)Format & BOOT_LOG_ADDRESS_MASK) |
+                              ((UINT64)Count << BOOT_LOG_COUNT_SHIFT) | Flags;
+    for (UINTN i = 0; i < Count; i++)
+        BootLogBuffer[head + BOOT_LOG_HEADER_WORDS + i] = Args[i];
+    BootLogHead = head + BOOT_LOG_HEADER_WORDS + Count;
+
+    if (BootLogConsole)
+        BootLogFlush();
+}
+
+// Converts one argument to its record word. The inner selection yields a `double` for floating-point
+// arguments and a `UINTN` for everything else, so that pointers and integers alike are converted by value.
+#define BOOT_LOG_WORD(x)                                                                                     \
+    _Generic((x), float : BootLogDoubleBits, double : BootLogDoubleBits, default : BootLogIntegerBits)(     \
+    _Generic((x), float : (x), double : (x), default : (UINTN)(x)))
+
+#define BOOT_LOG_CONCAT_(a, b)      a##b
+#define BOOT_LOG_CONCAT(a, b)       BOOT_LOG_CONCAT_(a, b)
+#define BOOT_LOG_COUNT_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+#define BOOT_LOG_COUNT(...)         BOOT_LOG_COUNT_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define BOOT_LOG_PACK_0(...)
+#define BOOT_LOG_PACK_1(a)          BOOT_LOG_WORD(a),
+#define BOOT_LOG_PACK_2(a, ...)     BOOT_LOG_WORD(a), BOOT_LOG_PACK_1(__VA_ARGS__)
+#define BOOT_LOG_PACK_3(a, ...)     BOOT_LOG_WORD(a), BOOT_LOG_PACK_2(__VA_ARGS__)
+#define BOOT_LOG_PACK_4(a, ...)     BOOT_LOG_WORD(a), BOOT_LOG_PACK_3(__VA_ARGS__)
+#define BOOT_LOG_PACK_5(a, ...)     BOOT_LOG_WORD(a), BOOT_LOG_PACK_4(__VA_ARGS__)
+#define BOOT_LOG_PACK_6(a, ...)     BOOT_LOG_WORD(a), BOOT_LOG_PACK_5(__VA_ARGS__)
+#define BOOT_LOG_PACK_7(a, ...)     BOOT_LOG_WORD(a), BOOT_LOG_PACK_6(__VA_ARGS__)
+#define BOOT_LOG_PACK_8(a, ...)     BOOT_LOG_WORD(a), BOOT_LOG_PACK_7(__VA_ARGS__)
+#define BOOT_LOG_PACK(...)          BOOT_LOG_CONCAT(BOOT_LOG_PACK_, BOOT_LOG_COUNT(__VA_ARGS__))(__VA_ARGS__)
+
+// Records a log entry without formatting it. Takes the same format strings and specifiers as `Print`, narrow
+// or CHAR16, with up to `BOOT_LOG_MAX_ARGS` arguments. String arguments are stored as pointers and must stay
+// valid until the record is rendered or exported.
+#define BootLog(Format, ...)                                                                                 \
+    BootLogWrite((Format),                                                                                   \
+                 _Generic((Format), char *         : 0,                                                      \
+                                    const char *   : 0,                                                      \
+                                    CHAR16 *       : BOOT_LOG_WIDE,                                          \
+                                    const CHAR16 * : BOOT_LOG_WIDE),                                         \
+                 BOOT_LOG_COUNT(__VA_ARGS__), (const UINT64[]){ BOOT_LOG_PACK(__VA_ARGS__) 0 })
+
+#endif /* BOOT_LOG_H */
@@ -0,0 +1,109 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Implementation File, Boot Stage Markers                                                    //
+// Filename    : bootstage.c                                                                                //
+// Description : Implements the boot stage markers. The lines are assembled by hand rather than through     //
+//               Print so that a marker costs a handful of port writes and does not disturb the timings it  //
+//               reports.                                                                                   //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <efi.h>
+#include <efilib.h>
+#include <stdbool.h>
+
+#include "bootlog.h"
+#include "bootstage.h"
+
+#ifdef BOOT_STAGE_MARKERS
+
+static inline void WritePort(UINT16 Port, UINT8 Value)
+{
+    __asm__ volatile ("outb %0, %1" : : "a"(Value), "Nd"(Port));
+}
+
+static inline UINT8 ReadPort(UINT16 Port)
+{
+    UINT8 value;
+    __asm__ volatile ("inb %1, %0" : "=a"(value) : "Nd"(Port));
+    return value;
+}
+
+/// @brief Reports whether a debug console is listening on `BOOT_STAGE_PORT`. Without one, the markers are
+///        skipped rather than written to whatever device, if any, decodes the port.
+static bool DebugConsolePresent(void)
+{
+    static int present = -1;
+    if (present < 0)
+        present = ReadPort(BOOT_STAGE_PORT) == BOOT_STAGE_PORT;
+    return present;
+}
+
+static void WriteString(const char *String)
+{
+    while (*String != 0)
+        WritePort(BOOT_STAGE_PORT, (UINT8)*String++);
+}
+
+static void WriteNumber(UINT64 Value, UINT32 Base)
+{
+    char digits[24];
+    UINTN count = 0;
+    do {
+        digits[count++] = "0123456789abcdef"[Value % Base];
+        Value /= Base;
+    } while (Value != 0);
+    while (count > 0)
+        WritePort(BOOT_STAGE_PORT, (UINT8)digits[--count]);
+}
+
+/// @brief Reports that the boot has reached the stage `Name`. The timestamp is taken before anything is
+///        written, so the cost of the marker is charged to the stage that follows it.
+/// @param Name the name of the stage, which must not contain spaces
+void BootStage(const char *Name)
+{
+    UINT64 timestamp = ReadTimestamp();
+    if (!DebugConsolePresent())
+        return;
+    WriteString("shasta: stage ");
+    WriteString(Name);
+    WriteString(" tsc ");
+    WriteNumber(timestamp, 16);
+    WriteString("\n");
+}
+
+/// @brief Measures the timestamp counter frequency against `Stall` and reports it, so that the benchmark can
+///        convert the markers to time. Called after the last stage, where the delay does not count.
+/// @param BS the `EFI_BOOT_SERVICES` table
+void BootStageCalibrate(EFI_BOOT_SERVICES *BS)
+{
+    if (!DebugConsolePresent())
+        return;
+    UINT64 start = ReadTimestamp();
+    BS->Stall(BOOT_STAGE_CALIBRATION_US);
+    UINT64 ticks = ReadTimestamp() - start;
+    WriteString("shasta: tsc-hz ");
+    WriteNumber(ticks * (1000000 / BOOT_STAGE_CALIBRATION_US), 10);
+    WriteString("\n");
+}
+
+#endif /* BOOT_STAGE_MARKERS */
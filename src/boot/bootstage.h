@@ -0,0 +1,56 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Header File, Boot Stage Markers                                                            //
+// Filename    : bootstage.h                                                                                //
+// Description : Declares the boot stage markers, which report the timestamp counter at each stage of the   //
+//               boot up to the kernel handoff through the QEMU/Bochs debug console port for the boot       //
+//               benchmark.                                                                                 //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <efi.h>
+#include <efilib.h>
+
+#ifndef BOOT_STAGE_H
+#define BOOT_STAGE_H
+
+#define BOOT_STAGE_PORT             0xE9            // QEMU/Bochs debug console; reads back 0xE9 when present
+#define BOOT_STAGE_CALIBRATION_US   10000
+
+// Each marker is written to the debug console as one line:
+//
+//      shasta: stage <name> tsc <timestamp counter, hex>
+//
+// and `BootStageCalibrate` follows the last of them with `shasta: tsc-hz <ticks per second, decimal>`. The
+// timestamp counter starts from zero when the virtual machine is reset, so each marker is also the time since
+// power-on. Markers are only compiled in when `BOOT_STAGE_MARKERS` is defined (the benchmark build in
+// test/boot/bench defines it); the simulator in test/boot/sim runs as a Linux process and cannot do port I/O.
+
+#ifdef BOOT_STAGE_MARKERS
+void        BootStage               (const char *);
+void        BootStageCalibrate      (EFI_BOOT_SERVICES *);
+#else
+#define     BootStage(Name)         ((void)0)
+#define     BootStageCalibrate(BS)  ((void)0)
+#endif
+
+#endif /* BOOT_STAGE_H */
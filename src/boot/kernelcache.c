@@ -0,0 +1,140 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Implementation File, Kernel Location Cache                                                 //
+// Filename    : kernelcache.c                                                                              //
+// Description : Provides a cache, stored in a UEFI variable, of the volume on which the kernel was last    //
+//               found, which lets the bootloader skip enumerating every file system when the kernel is not //
+//               on the boot volume.                                                                        //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include "kernelcache.h"
+#include "uefiutil.h"
+
+#define HASH_PRIME  0x00000100000001B3ULL
+
+static EFI_GUID KernelCacheGuid = KERNEL_CACHE_GUID;
+
+/// @brief Computes a 64-bit FNV-1a style hash over a buffer, folding in whole 64-bit words at a time and any
+///        trailing bytes individually.
+/// @param Hash   the running hash value; `HASH_INITIAL` for a new hash
+/// @param Buffer the data to hash
+/// @param Size   the number of bytes in `Buffer`
+/// @return       the updated hash value
+UINT64 HashBytes(UINT64 Hash, const VOID *Buffer, UINTN Size)
+{
+    const UINT8 *bytes = Buffer;
+    UINTN i = 0;
+
+    for (; i + sizeof(UINT64) <= Size; i += sizeof(UINT64)) {
+        UINT64 word;
+        __builtin_memcpy(&word, bytes + i, sizeof(UINT64));
+        Hash = (Hash ^ word) * HASH_PRIME;
+    }
+    for (; i < Size; i++)
+        Hash = (Hash ^ bytes[i]) * HASH_PRIME;
+
+    return Hash;
+}
+
+/// @brief Computes the checksum of a cache record, excluding the `Checksum` field itself.
+/// @param Cache the cache record
+/// @return      the checksum of the record
+UINT64 KernelCacheChecksum(const struct KernelCache *Cache)
+{
+    const UINT8 *bytes = (const UINT8 *)Cache;
+    UINTN offset = __builtin_offsetof(struct KernelCache, Checksum);
+    UINTN next = offset + sizeof(Cache->Checksum);
+
+    UINT64 hash = HashBytes(HASH_INITIAL, bytes, offset);
+    return HashBytes(hash, bytes + next, sizeof(struct KernelCache) - next);
+}
+
+/// @brief Reads the cache record from NVRAM and checks its integrity. This only validates the record itself;
+///        the caller is responsible for confirming that the cached device and files are still present.
+/// @param Cache receives the cache record
+/// @return      `EFI_SUCCESS` if a well-formed record was read; `EFI_NOT_FOUND` if there is no record;
+///              `EFI_INCOMPATIBLE_VERSION` if it was written by another bootloader version; or
+///              `EFI_VOLUME_CORRUPTED` if the record fails its integrity checks
+EFI_STATUS LoadKernelCache(struct KernelCache *Cache)
+{
+    UINTN size = sizeof(struct KernelCache);
+    UINT32 attributes;
+
+    EFI_STATUS status = UefiGetVariable(KERNEL_CACHE_VARIABLE, &KernelCacheGuid, &attributes, &size, Cache);
+    if (status == EFI_BUFFER_TOO_SMALL)
+        return EFI_VOLUME_CORRUPTED;
+    if (EFI_ERROR(status))
+        return status;
+
+    if (size != sizeof(struct KernelCache) || Cache->Signature != KERNEL_CACHE_SIGNATURE)
+        return EFI_VOLUME_CORRUPTED;
+    if (Cache->Version != KERNEL_CACHE_VERSION)
+        return EFI_INCOMPATIBLE_VERSION;
+    if (Cache->FileCount > KERNEL_CACHE_MAX_FILES || Cache->DevicePathSize > KERNEL_CACHE_MAX_DEVICE_PATH)
+        return EFI_VOLUME_CORRUPTED;
+    if (Cache->Checksum != KernelCacheChecksum(Cache))
+        return EFI_VOLUME_CORRUPTED;
+
+    // Each file's path must be terminated within its field.
+    for (UINTN i = 0; i < Cache->FileCount; i++) {
+        if (Cache->Files[i].Path[KERNEL_CACHE_MAX_PATH - 1] != 0)
+            return EFI_VOLUME_CORRUPTED;
+    }
+
+    return EFI_SUCCESS;
+}
+
+/// @brief Stamps the cache record with its signature, version and checksum and writes it to NVRAM. If an
+///        identical record is already stored, the write is skipped to spare the flash.
+/// @param Cache the cache record to store
+/// @return      an `EFI_STATUS` indicating the result of the call to `SetVariable`
+EFI_STATUS StoreKernelCache(struct KernelCache *Cache)
+{
+    struct KernelCache current;
+
+    Cache->Signature = KERNEL_CACHE_SIGNATURE;
+    Cache->Version = KERNEL_CACHE_VERSION;
+    Cache->Checksum = KernelCacheChecksum(Cache);
+
+    if (!EFI_ERROR(LoadKernelCache(&current)) && current.Checksum == Cache->Checksum) {
+        const UINT8 *a = (const UINT8 *)&current, *b = (const UINT8 *)Cache;
+        UINTN i = 0;
+        while (i < sizeof(struct KernelCache) && a[i] == b[i])
+            i++;
+        if (i == sizeof(struct KernelCache))
+            return EFI_SUCCESS;
+    }
+
+    return UefiSetVariable(KERNEL_CACHE_VARIABLE, &KernelCacheGuid, KERNEL_CACHE_ATTRIBUTES,
+                       sizeof(struct KernelCache), Cache);
+}
+
+/// @brief Deletes the cache record from NVRAM, forcing the next boot to take the full lookup path.
+/// @return an `EFI_STATUS` indicating the result of the call to `SetVariable`; a missing record is not an
+///         error
+EFI_STATUS InvalidateKernelCache(void)
+{
+    EFI_STATUS status = UefiSetVariable(KERNEL_CACHE_VARIABLE, &KernelCacheGuid, KERNEL_CACHE_ATTRIBUTES,
+                                    0, NULL);
+    return (status == EFI_NOT_FOUND) ? EFI_SUCCESS : status;
+}
@@ -0,0 +1,76 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Header File, Kernel Location Cache                                                         //
+// Filename    : kernelcache.h                                                                              //
+// Description : Provides a cache, stored in a UEFI variable, of the volume on which the kernel was last    //
+//               found, which lets the bootloader skip enumerating every file system when the kernel is not //
+//               on the boot volume.                                                                        //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <efi.h>
+#include <efilib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef KERNEL_CACHE_H
+#define KERNEL_CACHE_H
+
+#define KERNEL_CACHE_SIGNATURE          0x4C4B4853      // 'SHKL'
+#define KERNEL_CACHE_VERSION            2
+#define KERNEL_CACHE_MAX_FILES          4
+#define KERNEL_CACHE_MAX_PATH           64
+#define KERNEL_CACHE_MAX_DEVICE_PATH    256
+#define KERNEL_CACHE_VARIABLE           L"ShastaKernelCache"
+#define KERNEL_CACHE_ATTRIBUTES         (EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS)
+#define KERNEL_CACHE_GUID \
+    { 0x5a1e6c3b, 0x9d2f, 0x4e8a, { 0xb1, 0x67, 0x3c, 0x0d, 0x52, 0x8e, 0x94, 0xa7 } }
+
+#define HASH_INITIAL                    0xCBF29CE484222325ULL
+
+// A file resolved on a previous boot. It is read back through the file system, so the recorded size is only
+// used to reject a replaced file before any of it is read.
+struct KernelCacheFile {
+    CHAR16 Path[KERNEL_CACHE_MAX_PATH];
+    UINT64 Size;
+};
+
+// The complete cache record, stored verbatim in the `ShastaKernelCache` variable. `Checksum` covers the
+// whole record (with the checksum field itself excluded) and guards against torn or stale NVRAM contents.
+struct KernelCache {
+    UINT32                 Signature;
+    UINT16                 Version;
+    UINT16                 FileCount;
+    UINT32                 DevicePathSize;
+    UINT32                 Reserved;
+    UINT64                 Checksum;
+    UINT8                  DevicePath[KERNEL_CACHE_MAX_DEVICE_PATH];
+    struct KernelCacheFile Files[KERNEL_CACHE_MAX_FILES];
+};
+
+UINT64      HashBytes               (UINT64, const VOID *, UINTN);
+UINT64      KernelCacheChecksum     (const struct KernelCache *);
+EFI_STATUS  LoadKernelCache         (struct KernelCache *);
+EFI_STATUS  StoreKernelCache        (struct KernelCache *);
+EFI_STATUS  InvalidateKernelCache   (void);
+
+#endif /* KERNEL_CACHE_H */
@@ -0,0 +1,235 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Implementation File, Kernel Loader                                                         //
+// Filename    : loader.c                                                                                   //
+// Description : Locates and reads the kernel image: from the boot volume when it is there, otherwise from  //
+//               the volume recorded in the kernel location cache, and failing both by searching every file //
+//               system.                                                                                    //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include "loader.h"
+#include "bootlog.h"
+#include "bootstage.h"
+#include "kernelcache.h"
+#include "uefiutil.h"
+
+#define FILE_INFO_BUFFER_SIZE   (sizeof(EFI_FILE_INFO) + KERNEL_CACHE_MAX_PATH * sizeof(CHAR16))
+
+static EFI_GUID LoadedImageGuid = EFI_LOADED_IMAGE_PROTOCOL_GUID;
+static EFI_GUID FileSystemGuid  = EFI_SIMPLE_FILE_SYSTEM_PROTOCOL_GUID;
+static EFI_GUID DevicePathGuid  = EFI_DEVICE_PATH_PROTOCOL_GUID;
+static EFI_GUID FileInfoGuid    = EFI_FILE_INFO_ID;
+
+/// @brief Measures a device path, including its end node.
+/// @param Path the device path to measure
+/// @return     the size of the device path in bytes
+static UINTN DevicePathLength(EFI_DEVICE_PATH *Path)
+{
+    UINTN length = 0;
+    while (!IsDevicePathEnd(Path)) {
+        length += DevicePathNodeLength(Path);
+        Path = NextDevicePathNode(Path);
+    }
+    return length + DevicePathNodeLength(Path);
+}
+
+/// @brief Opens `Path` relative to `Root` and reads the whole file into a newly allocated buffer.
+/// @param Root         the root directory of the volume
+/// @param Path         the path of the file to read
+/// @param ExpectedSize the size the file must have, or zero to accept any size; a mismatch is detected from
+///                     the file information alone, before any data is read
+/// @param Buffer       receives the allocated buffer holding the file contents
+/// @param Size         receives the size of the file in bytes
+/// @return             an `EFI_STATUS` indicating the result of the operation
+static EFI_STATUS ReadFile(EFI_FILE_HANDLE Root, CHAR16 *Path, UINT64 ExpectedSize, VOID **Buffer,
+                           UINTN *Size)
+{
+    UINT64 infoBuffer[(FILE_INFO_BUFFER_SIZE + sizeof(UINT64) - 1) / sizeof(UINT64)];
+    EFI_FILE_INFO *info = (EFI_FILE_INFO *)infoBuffer;
+    UINTN infoSize = sizeof(infoBuffer);
+    EFI_FILE_HANDLE file;
+
+    EFI_STATUS status = Root->Open(Root, &file, Path, EFI_FILE_MODE_READ, 0);
+    if (EFI_ERROR(status))
+        return status;
+
+    status = file->GetInfo(file, &FileInfoGuid, &infoSize, info);
+    if (!EFI_ERROR(status) && ExpectedSize != 0 && info->FileSize != ExpectedSize)
+        status = EFI_NOT_FOUND;
+    if (!EFI_ERROR(status))
+        status = UefiAllocatePool(EfiLoaderData, info->FileSize, Buffer);
+    if (!EFI_ERROR(status)) {
+        *Size = info->FileSize;
+        status = file->Read(file, Size, *Buffer);
+        if (!EFI_ERROR(status) && *Size != info->FileSize)
+            status = EFI_VOLUME_CORRUPTED;
+        if (EFI_ERROR(status))
+            UefiFreePool(*Buffer);
+    }
+
+    file->Close(file);
+    return status;
+}
+
+/// @brief Opens the root directory of the Simple File System on `Handle` and reads `Path` from it.
+static EFI_STATUS ReadFileFromHandle(EFI_BOOT_SERVICES *BS, EFI_HANDLE Handle, CHAR16 *Path,
+                                     UINT64 ExpectedSize, VOID **Buffer, UINTN *Size)
+{
+    EFI_SIMPLE_FILE_SYSTEM_PROTOCOL *fs;
+    EFI_FILE_HANDLE root;
+
+    EFI_STATUS status = BS->HandleProtocol(Handle, &FileSystemGuid, (VOID **)&fs);
+    if (EFI_ERROR(status))
+        return status;
+    status = fs->OpenVolume(fs, &root);
+    if (EFI_ERROR(status))
+        return status;
+
+    status = ReadFile(root, Path, ExpectedSize, Buffer, Size);
+    root->Close(root);
+    return status;
+}
+
+/// @brief Reads the kernel from the volume recorded in the cache. The cached device path must still resolve
+///        to a file system, and the file there must still have the cached size; otherwise the caller falls
+///        back to searching every volume.
+static EFI_STATUS LoadFromCache(EFI_BOOT_SERVICES *BS, struct KernelCache *Cache, struct KernelImage *Kernel)
+{
+    UINT64 pathBuffer[KERNEL_CACHE_MAX_DEVICE_PATH / sizeof(UINT64)];
+    struct KernelCacheFile *file = &Cache->Files[0];
+    EFI_DEVICE_PATH *remaining = (EFI_DEVICE_PATH *)pathBuffer;
+    EFI_HANDLE device;
+
+    if (Cache->FileCount == 0 || Cache->DevicePathSize == 0)
+        return EFI_NOT_FOUND;
+    __builtin_memcpy(pathBuffer, Cache->DevicePath, Cache->DevicePathSize);
+
+    EFI_STATUS status = BS->LocateDevicePath(&FileSystemGuid, &remaining, &device);
+    if (EFI_ERROR(status) || !IsDevicePathEnd(remaining))
+        return EFI_NOT_FOUND;
+    status = ReadFileFromHandle(BS, device, file->Path, file->Size, &Kernel->Buffer, &Kernel->Size);
+    if (EFI_ERROR(status))
+        return status;
+
+    Kernel->Source = KernelSourceCache;
+    return EFI_SUCCESS;
+}
+
+/// @brief Records the device on which the kernel was found, and the kernel's path and size, in `Cache`.
+static void FillCache(EFI_BOOT_SERVICES *BS, EFI_HANDLE Device, struct KernelImage *Kernel,
+                      struct KernelCache *Cache)
+{
+    EFI_DEVICE_PATH *path;
+
+    for (UINTN i = 0; i < sizeof(struct KernelCache); i++)
+        ((UINT8 *)Cache)[i] = 0;
+
+    if (EFI_ERROR(BS->HandleProtocol(Device, &DevicePathGuid, (VOID **)&path)))
+        return;
+    UINTN length = DevicePathLength(path);
+    if (length > KERNEL_CACHE_MAX_DEVICE_PATH)
+        return;
+    __builtin_memcpy(Cache->DevicePath, path, length);
+    Cache->DevicePathSize = length;
+
+    CHAR16 *source = KERNEL_PATH;
+    for (UINTN i = 0; source[i] != 0 && i < KERNEL_CACHE_MAX_PATH - 1; i++)
+        Cache->Files[0].Path[i] = source[i];
+    Cache->Files[0].Size = Kernel->Size;
+    Cache->FileCount = 1;
+}
+
+/// @brief Full lookup: looks for the kernel on every volume exposing the Simple File System protocol other
+///        than `BootDevice`, which the caller has already tried.
+static EFI_STATUS SearchFileSystems(EFI_BOOT_SERVICES *BS, EFI_HANDLE BootDevice, struct KernelImage *Kernel,
+                                    EFI_HANDLE *Device)
+{
+    EFI_HANDLE *handles;
+    UINTN handleCount;
+
+    EFI_STATUS status = BS->LocateHandleBuffer(ByProtocol, &FileSystemGuid, NULL, &handleCount, &handles);
+    if (EFI_ERROR(status))
+        return status;
+
+    status = EFI_NOT_FOUND;
+    for (UINTN i = 0; i < handleCount && EFI_ERROR(status); i++) {
+        if (handles[i] == BootDevice)
+            continue;
+        *Device = handles[i];
+        status = ReadFileFromHandle(BS, *Device, KERNEL_PATH, 0, &Kernel->Buffer, &Kernel->Size);
+    }
+
+    UefiFreePool(handles);
+    return status;
+}
+
+/// @brief Locates and reads the kernel image. The volume the bootloader was loaded from is tried first, which
+///        costs no more than a cache lookup would and needs no NVRAM access. Only if the kernel is not there
+///        is the kernel location cache consulted; if it is missing or stale, every other volume is searched
+///        and the cache is rewritten for the next boot. The cache therefore saves the enumeration of every
+///        file system, not the file system opens and lookups on the volume that holds the kernel.
+/// @param ImageHandle the `EFI_HANDLE` passed to `efi_main`
+/// @param SystemTable the `EFI_SYSTEM_TABLE` passed to `efi_main`
+/// @param Kernel      receives the kernel image
+/// @return            an `EFI_STATUS` indicating the result of the operation
+EFI_STATUS LoadKernel(EFI_HANDLE ImageHandle, EFI_SYSTEM_TABLE *SystemTable, struct KernelImage *Kernel)
+{
+    EFI_BOOT_SERVICES *BS = SystemTable->BootServices;
+    EFI_LOADED_IMAGE *loadedImage;
+    EFI_HANDLE bootDevice = NULL;
+    struct KernelCache cache;
+    EFI_HANDLE device = NULL;
+
+    EFI_STATUS status = BS->HandleProtocol(ImageHandle, &LoadedImageGuid, (VOID **)&loadedImage);
+    if (!EFI_ERROR(status)) {
+        bootDevice = loadedImage->DeviceHandle;
+        status = ReadFileFromHandle(BS, bootDevice, KERNEL_PATH, 0, &Kernel->Buffer, &Kernel->Size);
+        if (!EFI_ERROR(status)) {
+            BootLog("loader: read %lu bytes from the boot volume\r\n", Kernel->Size);
+            Kernel->Source = KernelSourceBootVolume;
+            return EFI_SUCCESS;
+        }
+    }
+
+    status = LoadKernelCache(&cache);
+    BootStage("cache");
+    BootLog("loader: kernel location cache %s\r\n", EFI_ERROR(status) ? "absent" : "present");
+    if (!EFI_ERROR(status) && !EFI_ERROR(LoadFromCache(BS, &cache, Kernel))) {
+        BootLog("loader: read %lu bytes using the cache\r\n", Kernel->Size);
+        return EFI_SUCCESS;
+    }
+
+    status = SearchFileSystems(BS, bootDevice, Kernel, &device);
+    if (EFI_ERROR(status)) {
+        BootLog("loader: %ls not found (status %lx)\r\n", KERNEL_PATH, status);
+        InvalidateKernelCache();
+        return status;
+    }
+    BootLog("loader: read %lu bytes by full lookup\r\n", Kernel->Size);
+    Kernel->Source = KernelSourceSearch;
+
+    FillCache(BS, device, Kernel, &cache);
+    if (cache.DevicePathSize != 0)
+        StoreKernelCache(&cache);
+    return EFI_SUCCESS;
+}
@@ -1,14 +1,14 @@
 // -------------------------------------------------------------------------------------------------------- //
-// Title       : UEFI Test Harnesses (Header), UEFI Print Utility Tests, UEFI Bootloader Test Suite         //
-// Filename    : main.c                                                                                     //
-// Description : Provides the header file for some UEFI test functionality harnesses. Mimics several UEFI   //
-//               functions incorporated into /src/boot/uefiutil.h using C standard functions to provide 1:1 //
-//               testing of the Print logic.                                                                //
+// Title       : Header File, Kernel Loader                                                                 //
+// Filename    : loader.h                                                                                   //
+// Description : Locates and reads the kernel image: from the boot volume when it is there, otherwise from  //
+//               the volume recorded in the kernel location cache, and failing both by searching every file //
+//               system.                                                                                    //
 //                                                                                                          //
 // Project     : Shasta Microkernel                                                                         //
 // Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
-// Created     : August 30, 2023                                                                            //
-// Modified    : August 31, 2023                                                                            //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
 // Version     : 0.0.0                                                                                      //
 // License     : GNU General Public License (GPL) version 3.0                                               //
 // Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
@@ -27,43 +27,31 @@
 //     <http://www.gnu.org/licenses/>.                                                                      //
 // -------------------------------------------------------------------------------------------------------- //
 
-#ifndef UEFI_HARNESS_H_INCLUDED
-#define UEFI_HARNESS_H_INCLUDED
-
-#include <stdio.h>
-#include <stdarg.h>
+#include <efi.h>
+#include <efilib.h>
 #include <stdint.h>
-#include <stdlib.h>
 #include <stdbool.h>
 
-#define EFI_SUCCESS             0x00000000
-#define EFI_LOAD_ERROR          0x80000001
-#define EFI_INVALID_PARAMETER   0x80000002
-#define EFI_UNSUPPORTED         0x80000003
-#define EFI_BAD_BUFFER_SIZE     0x80000004
-#define EFI_BUFFER_TOO_SMALL    0x80000005
-#define EFI_NOT_READY           0x80000006
-#define EFI_DEVICE_ERROR        0x80000007
-#define EFI_WRITE_PROTECTED     0x80000008
-#define EFI_OUT_OF_RESOURCES    0x80000009
-#define EFI_VOLUME_CORRUPTED    0x8000000A
-#define EFI_VOLUME_FULL         0x8000000B
-#define EFI_NO_MEDIA            0x8000000C
-#define EFI_MEDIA_CHANGED       0x8000000D
-#define EFI_NOT_FOUND           0x8000000E
-#define EFI_ACCESS_DENIED       0x8000000F
-#define EFI_NO_RESPONSE         0x80000010
-#define EFI_NO_MAPPING          0x80000011
-#define EFI_TIMEOUT             0x80000012
-#define EFI_NOT_STARTED         0x80000013
+#ifndef KERNEL_LOADER_H
+#define KERNEL_LOADER_H
+
+#define KERNEL_PATH     L"\\shasta\\kernel.elf"
 
-#define EfiLoaderData           0x00000001
+// Where a kernel image was found: on the volume the bootloader was loaded from, on the volume recorded in the
+// kernel location cache, or by searching every other volume (the full lookup path).
+enum KernelSource {
+    KernelSourceBootVolume,
+    KernelSourceCache,
+    KernelSourceSearch
+};
 
-typedef uint32_t EFI_STATUS;
-typedef uint32_t EFI_MEMORY_TYPE;
+// A kernel image read into memory, and the path by which it was located.
+struct KernelImage {
+    VOID              *Buffer;
+    UINTN              Size;
+    enum KernelSource  Source;
+};
 
-bool       EFI_ERROR   (EFI_STATUS Status);
-EFI_STATUS AllocatePool(EFI_MEMORY_TYPE EfiType, uint32_t BufferSize, void **Buffer);
-EFI_STATUS FreePool    (void *Buffer);
+EFI_STATUS  LoadKernel  (EFI_HANDLE, EFI_SYSTEM_TABLE *, struct KernelImage *);
 
-#endif // UEFI_HARNESS_H_INCLUDED
+#endif /* KERNEL_LOADER_H */
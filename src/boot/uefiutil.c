@@ -7,7 +7,7 @@
 // Project     : Shasta Microkernel                                                                         //
 // Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
 // Created     : August 29, 2023                                                                            //
-// Modified    : August 29, 2023                                                                            //
+// Modified    : October 19, 2026                                                                           //
 // Version     : 0.0.0                                                                                      //
 // License     : GNU General Public License (GPL) version 3.0                                               //
 // Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
@@ -28,164 +28,691 @@
 
 #include "uefiutil.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define PRINT_BUFFER_LENGTH     256
+#define CONVERSION_BUFFER_SIZE  64
+#define DEFAULT_FLOAT_PRECISION 6
+#define MAX_FLOAT_PRECISION     15
+
 static EFI_HANDLE        IH;
-static EFI_SYSTEM_TABLE *ST;
+static EFI_SYSTEM_TABLE *SystemTablePtr;
 
 struct FormatSpecifier {
-    int  location;
     char format;
     char modifier;
     int  width;
     int  precision;
+    bool hasPrecision;
+    bool padZero;
 };
 
-size_t  StringLength        (const char *);
-size_t  ParseFormattedString(const char *, struct FormatSpecifier *, size_t);
+// Output sink for the CHAR16 formatter. Characters are written directly into `Buffer`; when `Capacity` is
+// reached the buffer is handed to `Flush` (if set) and reused, otherwise further output is truncated. `Total`
+// counts every character produced, including any which were truncated. `Buffer` may be `NULL` when `Capacity`
+// is zero, in which case only `Total` is computed. `Status` holds the first error returned by `Flush`.
+struct PrintBuffer {
+    CHAR16     *Buffer;
+    size_t      Capacity;
+    size_t      Length;
+    size_t      Total;
+    EFI_STATUS (*Flush)(const CHAR16 *String);
+    EFI_STATUS  Status;
+};
+
+// Source of the arguments for the formatter: either a variadic argument list or, when `Words` is set, the
+// packed argument words of a deferred log record.
+struct FormatArguments {
+    va_list       List;
+    const UINT64 *Words;
+    size_t        Count;
+    size_t        Index;
+};
 
-/// @brief InitializeLib stores local copies of the EFI image and system table handles.
+void        WidenAscii  (CHAR16 *, const char *, size_t);
+EFI_STATUS  FormatString(struct PrintBuffer *, const void *, bool, va_list);
+EFI_STATUS  FormatRecord(struct PrintBuffer *, const void *, bool, const UINT64 *, size_t);
+
+/// @brief UefiInitializeLib stores local copies of the EFI image and system table handles.
 /// @param ImageHandle the `EFI_HANDLE` passed to `efi_main`
 /// @param SystemTable the `EFI_SYSTEM_TABLE` passed to `efi_main`
-void InitializeLib(EFI_HANDLE ImageHandle, EFI_SYSTEM_TABLE *SystemTable) 
+void UefiInitializeLib(EFI_HANDLE ImageHandle, EFI_SYSTEM_TABLE *SystemTable) 
 {
     IH = ImageHandle;
-    ST = SystemTable;
+    SystemTablePtr = SystemTable;
 }
 
-/// @brief Requests a memory allocation of specified type and size to be mapped to the supplied pointer. This 
-///        version is modified from its UEFI original form to conform more closely to C native types and avoid 
-///        the double indirection (i.e. `VOID **`) of the underlying UEFI call.
+/// @brief Requests a memory allocation of specified type and size to be mapped to the supplied pointer.
 /// @param EfiType    the memory type to be allocated
 /// @param BufferSize the size of the buffer allocation desired
-/// @param Buffer     a supplied pointer to be pointed at the allocated memory area
+/// @param Buffer     a pointer to a pointer which will be aimed at the allocated memory area
 /// @return           an `EFI_STATUS` indicating the result of the call to `AllocatePool`
-EFI_STATUS AllocatePool(EFI_MEMORY_TYPE EfiType, uint64_t BufferSize, void *Buffer) 
+EFI_STATUS UefiAllocatePool(EFI_MEMORY_TYPE EfiType, UINTN BufferSize, VOID **Buffer) 
 {
-    return ST->BootServices->AllocatePool(EfiType, BufferSize, &Buffer);
+    return SystemTablePtr->BootServices->AllocatePool(EfiType, BufferSize, Buffer);
 }
 
-/// @brief Frees (releases) a memory allocation made via `AllocatePool`.
+/// @brief Frees (releases) a memory allocation made via `UefiAllocatePool`.
 /// @param Buffer a pointer to the allocated buffer
-/// @return       an `EFI_STATUS` indicating the result of the call to `AllocatePool`
-EFI_STATUS FreePool(void *Buffer) 
+/// @return       an `EFI_STATUS` indicating the result of the call to `FreePool`
+EFI_STATUS UefiFreePool(VOID *Buffer) 
+{
+    return SystemTablePtr->BootServices->FreePool(Buffer);
+}
+
+/// @brief Reads a UEFI variable through the runtime services table.
+/// @param Name       the NUL-terminated name of the variable
+/// @param Vendor     the vendor GUID of the variable
+/// @param Attributes receives the attributes of the variable; may be `NULL`
+/// @param DataSize   on entry, the size of `Data`; on exit, the size of the variable
+/// @param Data       the buffer which receives the contents of the variable
+/// @return           an `EFI_STATUS` indicating the result of the call to `GetVariable`
+EFI_STATUS UefiGetVariable(CHAR16 *Name, EFI_GUID *Vendor, UINT32 *Attributes, UINTN *DataSize, VOID *Data)
 {
-    return ST->BootServices->AllocatePool(Buffer);
+    return SystemTablePtr->RuntimeServices->GetVariable(Name, Vendor, Attributes, DataSize, Data);
 }
 
-/// @brief Provides a print function similar to `printf()` in the C standard library. Processes the most 
-///        useful subset of the available format specifiers and formatting modes. Note that this function will 
-///        only handle up to 256 characters by design due to internal fixed allocation strategies.
-/// @param fmt The formatted string to substitute and print
-/// @param ... A vararg list to inject into `fmt` in accordance with the format specifiers
-/// @return    an `EFI_STATUS` indicating the result of the call to `Print`
-EFI_STATUS Print(const char *fmt, ...) 
+/// @brief Writes (or, when `DataSize` is zero, deletes) a UEFI variable through the runtime services table.
+/// @param Name       the NUL-terminated name of the variable
+/// @param Vendor     the vendor GUID of the variable
+/// @param Attributes the attributes with which to store the variable
+/// @param DataSize   the size of `Data`
+/// @param Data       the contents of the variable
+/// @return           an `EFI_STATUS` indicating the result of the call to `SetVariable`
+EFI_STATUS UefiSetVariable(CHAR16 *Name, EFI_GUID *Vendor, UINT32 Attributes, UINTN DataSize, VOID *Data)
 {
-    // if the string is greater than 256 characters, error out - the fixed-length buffers
-    // allocated below will not handle it
-    if (StringLength(str) > 256)
-        return EFI_BUFFER_TOO_SMALL;
+    return SystemTablePtr->RuntimeServices->SetVariable(Name, Vendor, Attributes, DataSize, Data);
+}
 
-    // Allocate three buffers - one for the main string, one for the FormatSpecifier collection, and a final
-    // one for the working conversion variable.
-    char *printBuffer;
-    struct FormatSpecifier *formatSpecifiers;
-    char *conversionBuffer;
+/// @brief Writes a NUL-terminated CHAR16 string to the firmware console. Used as the flush callback of the
+///        `Print` output buffer.
+/// @param String the string to output
+/// @return       an `EFI_STATUS` indicating the result of the call to `OutputString`
+static EFI_STATUS ConsoleOutput(const CHAR16 *String)
+{
+    return SystemTablePtr->ConOut->OutputString(SystemTablePtr->ConOut, (CHAR16 *)String);
+}
 
-    EFI_STATUS printBufAllocStatus = AllocatePool(EfiLoaderData, 256, printBuffer);
-    EFI_STATUS fmtBufAllocStatus = AllocatePool(EfiLoaderData, 
-                                                16 * sizeof(struct FormatSpecifier), 
-                                                formatSpecifiers);
-    EFI_STATUS convBufAllocStatus = AllocatePool(EfiLoaderData, 64, conversionBuffer);
-    if (EFI_ERROR(printBufAllocStatus) || EFI_ERROR(fmtBufAllocStatus) || EFI_ERROR(convBufAllocStatus)) {
+/// @brief Widens `Count` ASCII (or Latin-1) characters from `Source` into the CHAR16 buffer `Dest`. When SSE2
+///        is available, 16 characters at a time are zero-extended by interleaving them with a zero register
+///        (`PUNPCKLBW`/`PUNPCKHBW`); any remainder is widened one character at a time.
+/// @param Dest   the CHAR16 buffer to write, which must hold at least `Count` elements
+/// @param Source the narrow characters to widen
+/// @param Count  the number of characters to widen
+void WidenAscii(CHAR16 *Dest, const char *Source, size_t Count)
+{
+    size_t i = 0;
 
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= Count; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(Source + i));
+        _mm_storeu_si128((__m128i *)(Dest + i), _mm_unpacklo_epi8(bytes, zero));
+        _mm_storeu_si128((__m128i *)(Dest + i + 8), _mm_unpackhi_epi8(bytes, zero));
     }
+#endif
+
+    for (; i < Count; i++)
+        Dest[i] = (CHAR16)(unsigned char)Source[i];
 }
 
-/// @brief Private helper function for `Print`. Returns string length. Assumes regular `char` code points, 
-///        rather than the 16-bit wide chars of UEFI printing implementations.
-/// @param str the string to measure
-/// @return    the length of the supplied string
-size_t StringLength(const char *str) 
+/// @brief Makes room in the output sink. If the sink is full, it is flushed (when a `Flush` callback is
+///        present) and reset; otherwise the remaining output is discarded.
+/// @param Out the output sink
+/// @return    the number of CHAR16 elements which may be written, or 0 if the output must be truncated
+static size_t ReserveSpace(struct PrintBuffer *Out)
 {
-    size_t i = 0;
-    while (str[i] != '\0')
-        i++;
-    return i;
-}
-
-/// @brief Parses the format string provided to `Print` and stores an array of `FormatSpecifier` elements in
-///        the location pointed to by the `fs` pointer. See the extended documentation for a complete list of
-///        format specifier codes supported by `ParseFormattedString` and its parent function `Print`.
-/// @param fmt      the formatter string provided to `Print`.
-/// @param fs       a pointer to the `FormatSpecifier` allocation block
-/// @param numalloc the number of `FormatSpecifier` elements allocated in the memory pointed to by `fs`
-/// @return         the number of format codes present in the formatter string
-size_t ParseFormattedString(const char *fmt, struct FormatSpecifier *fs, size_t numalloc) 
-{
-    int location = 0;
-    size_t specIndex = 0;
-    bool isSpecifier = false;
-
-    // Initialize all FormatSpecifier structs to zero.
-    for (int i = 0; i < numalloc; i++)
-        fs[i] = {0};
-
-    // Iterate over the format string.
-    while (*fmt) {
-        
-        // If the current character is a '%' and an open specifier has not yet been detected, set the 
-        // isSpecifier flag to true and save the location of this point in the current FormatSpecifier struct. 
-        // Increment format pointer, location, and continue.
-        if (*fmt == '%' && !isSpecifier) {
-            isSpecifier = true;
-            fs[specIndex].location = location;
-            fmt++;
-            location++;
-            continue;
+    if (Out->Length == Out->Capacity && Out->Flush != NULL) {
+        Out->Buffer[Out->Length] = 0;
+        EFI_STATUS status = Out->Flush(Out->Buffer);
+        if (EFI_ERROR(status) && !EFI_ERROR(Out->Status))
+            Out->Status = status;
+        Out->Length = 0;
+    }
+    return Out->Capacity - Out->Length;
+}
+
+/// @brief Appends a run of narrow characters to the output sink, widening them in place.
+static void AppendNarrow(struct PrintBuffer *Out, const char *Source, size_t Count)
+{
+    Out->Total += Count;
+    while (Count > 0) {
+        size_t space = ReserveSpace(Out);
+        if (space == 0)
+            return;
+        size_t n = (Count < space) ? Count : space;
+        WidenAscii(Out->Buffer + Out->Length, Source, n);
+        Out->Length += n;
+        Source += n;
+        Count -= n;
+    }
+}
+
+/// @brief Appends a run of CHAR16 characters to the output sink.
+static void AppendWide(struct PrintBuffer *Out, const CHAR16 *Source, size_t Count)
+{
+    Out->Total += Count;
+    while (Count > 0) {
+        size_t space = ReserveSpace(Out);
+        if (space == 0)
+            return;
+        size_t n = (Count < space) ? Count : space;
+        for (size_t i = 0; i < n; i++)
+            Out->Buffer[Out->Length + i] = Source[i];
+        Out->Length += n;
+        Source += n;
+        Count -= n;
+    }
+}
+
+/// @brief Appends `Count` copies of the character `c` to the output sink; used for field padding.
+static void AppendRepeat(struct PrintBuffer *Out, CHAR16 c, size_t Count)
+{
+    Out->Total += Count;
+    while (Count > 0) {
+        size_t space = ReserveSpace(Out);
+        if (space == 0)
+            return;
+        size_t n = (Count < space) ? Count : space;
+        for (size_t i = 0; i < n; i++)
+            Out->Buffer[Out->Length + i] = c;
+        Out->Length += n;
+        Count -= n;
+    }
+}
+
+/// @brief Returns the character at `Index` of a format string of either width.
+static inline CHAR16 FormatCharAt(const void *Format, bool IsWide, size_t Index)
+{
+    return IsWide ? ((const CHAR16 *)Format)[Index] : (CHAR16)((const unsigned char *)Format)[Index];
+}
+
+/// @brief Divides the 128-bit value held in `Limbs` (least significant first) by `Base` in place, using only
+///        64-bit arithmetic so that no compiler runtime support routines are required.
+/// @return the remainder of the division
+static uint32_t DivideLimbs(uint32_t Limbs[4], uint32_t Base)
+{
+    uint64_t remainder = 0;
+    for (int i = 3; i >= 0; i--) {
+        uint64_t current = (remainder << 32) | Limbs[i];
+        Limbs[i] = (uint32_t)(current / Base);
+        remainder = current % Base;
+    }
+    return (uint32_t)remainder;
+}
+
+/// @brief Converts an unsigned value of up to 128 bits into ASCII digits of the requested base.
+/// @param Buffer    the conversion buffer; must hold at least 43 characters
+/// @param High      the upper 64 bits of the value
+/// @param Low       the lower 64 bits of the value
+/// @param Base      the numeric base (8, 10 or 16)
+/// @param Uppercase whether hexadecimal digits should be uppercase
+/// @return          the number of digits written
+static size_t ConvertUnsigned(char *Buffer, uint64_t High, uint64_t Low, uint32_t Base, bool Uppercase)
+{
+    const char *digits = Uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    uint32_t limbs[4] = { (uint32_t)Low, (uint32_t)(Low >> 32), (uint32_t)High, (uint32_t)(High >> 32) };
+    size_t length = 0;
+
+    do {
+        Buffer[length++] = digits[DivideLimbs(limbs, Base)];
+    } while (limbs[0] | limbs[1] | limbs[2] | limbs[3]);
+
+    for (size_t i = 0; i < length / 2; i++) {
+        char t = Buffer[i];
+        Buffer[i] = Buffer[length - 1 - i];
+        Buffer[length - 1 - i] = t;
+    }
+    return length;
+}
+
+/// @brief Converts a floating-point value to ASCII in either fixed (`f`) or exponent (`e`/`E`) notation.
+///        Values too large to be represented with a 64-bit integer part are always converted in exponent
+///        notation.
+/// @param Buffer    the conversion buffer; must hold at least `CONVERSION_BUFFER_SIZE` characters
+/// @param Value     the (non-negative) value to convert
+/// @param Precision the number of fractional digits
+/// @param Format    the format character: 'f', 'e' or 'E'
+/// @return          the number of characters written
+static size_t ConvertFloat(char *Buffer, double Value, int Precision, char Format)
+{
+    size_t length = 0;
+    int exponent = 0;
+    bool exponential = (Format != 'f') || (Value >= 1.8e19);
+
+    if (Value != Value || Value > 1.7976931348623157e308) {
+        const char *special = (Value != Value) ? "nan" : "inf";
+        for (int i = 0; i < 3; i++)
+            Buffer[length++] = (Format == 'E') ? (char)(special[i] - 'a' + 'A') : special[i];
+        return length;
+    }
+
+    if (exponential && Value != 0.0) {
+        while (Value >= 10.0) {
+            Value /= 10.0;
+            exponent++;
+        }
+        while (Value < 1.0) {
+            Value *= 10.0;
+            exponent--;
+        }
+    }
+
+    uint64_t scale = 1;
+    for (int i = 0; i < Precision; i++)
+        scale *= 10;
+
+    uint64_t integer = (uint64_t)Value;
+    uint64_t fraction = (uint64_t)((Value - (double)integer) * (double)scale + 0.5);
+    if (fraction >= scale) {
+        fraction -= scale;
+        integer++;
+        if (exponential && integer >= 10) {
+            integer = 1;
+            exponent++;
         }
-        else if (isSpecifier) {
-
-            // If the next character is a '%', it is escaped - roll back the saved location
-            if (*fmt == '%') {
-                isSpecifier = false;
-                fs[specIndex].location = 0;
-            }
-
-            // If we haven't encountered a width yet, save the format character directly. As the format 
-            // character must necessarily be the last character in the format specifier sequence, this ends 
-            // the current specifier. Set isSpecifier to false; increment specIndex.
-            else if (*fmt == 'd' || *fmt == 'i' || *fmt == 'u' || *fmt == 'o' || *fmt == 'x' || *fmt == 'X' || 
-                     *fmt == 's' || *fmt == 'e' || *fmt == 'E' || *fmt == 'f') {
-                fs[specIndex].format = *fmt;
-                isSpecifier = false;
-                specIndex++;
-            }
-
-            // Handle any modifiers, widths, or precisions which may be specified.
-            else {
-                switch (*fmt) {
-                    case 'b':   // byte       (  8-bit)
-                    case 'h':   // halfword   ( 16-bit)
-                    case 'w':   // word       ( 32-bit)
-                    case 'd':   // doubleword ( 64-bit)
-                    case 'q':   // quadword   (128-bit)
-                        fs[specIndex].modifier = *fmt;
-                        break;
-                    case '0' ... '9':
-                        if (fs[specIndex].precision == -1) {
-                            fs[specIndex].width = (fs[specIndex].width == -1) ? 0;
-                            fs[specIndex].width = (fs[specIndex].width * 10) + (*fmt - '0');
-                        }
-                        else fs[specIndex].precision = (fs[specIndex].precision * 10) + (*fmt - '0');
-                        break;
-                    case '.':
-                        fs[specIndex].precision = 0;
-                        break;
-                }
-            }
+    }
+
+    length += ConvertUnsigned(Buffer, 0, integer, 10, false);
+    if (Precision > 0) {
+        char digits[MAX_FLOAT_PRECISION + 1];
+        size_t count = ConvertUnsigned(digits, 0, fraction, 10, false);
+        Buffer[length++] = '.';
+        for (size_t i = count; i < (size_t)Precision; i++)
+            Buffer[length++] = '0';
+        for (size_t i = 0; i < count; i++)
+            Buffer[length++] = digits[i];
+    }
+
+    if (exponential) {
+        Buffer[length++] = (Format == 'E') ? 'E' : 'e';
+        Buffer[length++] = (exponent < 0) ? '-' : '+';
+        unsigned magnitude = (exponent < 0) ? (unsigned)-exponent : (unsigned)exponent;
+        if (magnitude < 10)
+            Buffer[length++] = '0';
+        length += ConvertUnsigned(Buffer + length, 0, magnitude, 10, false);
+    }
+
+    return length;
+}
+
+/// @brief Returns the next packed argument word of a deferred record, or zero once the record is exhausted.
+static uint64_t NextWord(struct FormatArguments *Args)
+{
+    return (Args->Index < Args->Count) ? Args->Words[Args->Index++] : 0;
+}
+
+/// @brief Reads the next integer argument according to the specifier's format and size modifier, returning
+///        its magnitude split into two 64-bit halves and whether it was negative. Packed arguments occupy one
+///        word each, except for 128-bit (`q`) arguments, which occupy two (low half first); either way the
+///        value is then truncated and extended exactly as a variadic argument would be.
+static void FetchInteger(struct FormatSpecifier *fs, struct FormatArguments *Args, uint64_t *High,
+                         uint64_t *Low, bool *Negative)
+{
+    bool isSigned = (fs->format == 'd' || fs->format == 'i');
+    unsigned __int128 raw, magnitude;
+
+    if (Args->Words != NULL) {
+        raw = NextWord(Args);
+        if (fs->modifier == 'q')
+            raw |= (unsigned __int128)NextWord(Args) << 64;
+    }
+    else {
+        switch (fs->modifier) {
+            case 'l': raw = va_arg(Args->List, uint64_t);                break;
+            case 'q': raw = va_arg(Args->List, unsigned __int128);       break;
+            default:  raw = va_arg(Args->List, unsigned int);            break;
         }
+    }
 
-        fmt++;
+    *Negative = false;
+    if (isSigned) {
+        __int128 value;
+        switch (fs->modifier) {
+            case 'b': value = (int8_t)raw;      break;
+            case 'h': value = (int16_t)raw;     break;
+            case 'l': value = (int64_t)raw;     break;
+            case 'q': value = (__int128)raw;    break;
+            default:  value = (int32_t)raw;     break;
+        }
+        *Negative = (value < 0);
+        magnitude = *Negative ? -(unsigned __int128)value : (unsigned __int128)value;
+    }
+    else {
+        switch (fs->modifier) {
+            case 'b': magnitude = (uint8_t)raw;     break;
+            case 'h': magnitude = (uint16_t)raw;    break;
+            case 'l': magnitude = (uint64_t)raw;    break;
+            case 'q': magnitude = raw;              break;
+            default:  magnitude = (uint32_t)raw;    break;
+        }
     }
-    
-    return specIndex;
-}
\ No newline at end of file
+
+    *High = (uint64_t)(magnitude >> 64);
+    *Low = (uint64_t)magnitude;
+}
+
+/// @brief Reads the next floating-point argument. Packed arguments hold the bit pattern of a `double`.
+static double FetchFloat(struct FormatArguments *Args)
+{
+    if (Args->Words == NULL)
+        return va_arg(Args->List, double);
+    union { uint64_t Word; double Value; } bits = { NextWord(Args) };
+    return bits.Value;
+}
+
+/// @brief Reads the next pointer argument.
+static const void *FetchPointer(struct FormatArguments *Args)
+{
+    if (Args->Words == NULL)
+        return va_arg(Args->List, const void *);
+    return (const void *)(UINTN)NextWord(Args);
+}
+
+/// @brief Parses a single format specifier beginning just after its '%' character. The format characters `d`,
+///        `i`, `u`, `o`, `x`, `X`, `s`, `e`, `E`, `f` and `%` are supported, preceded by an optional field width
+///        (a leading '0' requests zero padding), precision, and size modifier: `b` (8-bit), `h` (16-bit), `w`
+///        (32-bit), `l` (64-bit) or `q` (128-bit). Unrecognized characters within the specifier are skipped.
+/// @param Format the format string
+/// @param IsWide whether `Format` is a CHAR16 string
+/// @param Index  on entry, the index following the '%'; on exit, the index following the specifier
+/// @param fs     the `FormatSpecifier` to fill in
+/// @return       false if the format string ended before a format character was found
+static bool ParseSpecifier(const void *Format, bool IsWide, size_t *Index, struct FormatSpecifier *fs)
+{
+    *fs = (struct FormatSpecifier){0};
+    bool isPrecision = false;
+
+    for (CHAR16 c; (c = FormatCharAt(Format, IsWide, *Index)) != 0; (*Index)++) {
+        switch (c) {
+            case '%': case 'd': case 'i': case 'u': case 'o': case 'x':
+            case 'X': case 's': case 'e': case 'E': case 'f':
+                fs->format = (char)c;
+                (*Index)++;
+                return true;
+            case 'b': case 'h': case 'w': case 'l': case 'q':
+                fs->modifier = (char)c;
+                break;
+            case '0' ... '9':
+                if (isPrecision)
+                    fs->precision = (fs->precision * 10) + (c - '0');
+                else if (c == '0' && fs->width == 0)
+                    fs->padZero = true;
+                else
+                    fs->width = (fs->width * 10) + (c - '0');
+                break;
+            case '.':
+                isPrecision = true;
+                fs->hasPrecision = true;
+                fs->precision = 0;
+                break;
+        }
+    }
+    return false;
+}
+
+/// @brief Emits a string argument, honouring the field width and using the precision as a maximum length. The
+///        argument has the width of the format string unless overridden by an `h` (narrow) or `l` (wide)
+///        modifier.
+static void EmitString(struct PrintBuffer *Out, struct FormatSpecifier *fs, bool IsWide,
+                       struct FormatArguments *Args)
+{
+    bool argIsWide = (fs->modifier == 'l') || (IsWide && fs->modifier != 'h');
+    const void *string = FetchPointer(Args);
+    size_t length = 0;
+
+    if (string == NULL) {
+        string = "(null)";
+        argIsWide = false;
+    }
+    while (FormatCharAt(string, argIsWide, length) != 0 &&
+           (!fs->hasPrecision || length < (size_t)fs->precision))
+        length++;
+
+    if ((size_t)fs->width > length)
+        AppendRepeat(Out, ' ', fs->width - length);
+    if (argIsWide)
+        AppendWide(Out, string, length);
+    else
+        AppendNarrow(Out, string, length);
+}
+
+/// @brief Emits a numeric argument. Digits are produced in a small ASCII conversion buffer and widened on
+///        output; padding is applied with spaces before the sign, or with zeros after it when requested.
+static void EmitNumber(struct PrintBuffer *Out, struct FormatSpecifier *fs, struct FormatArguments *Args)
+{
+    char conversion[CONVERSION_BUFFER_SIZE];
+    size_t length, digits;
+    bool negative;
+
+    if (fs->format == 'f' || fs->format == 'e' || fs->format == 'E') {
+        int precision = fs->hasPrecision ? fs->precision : DEFAULT_FLOAT_PRECISION;
+        if (precision > MAX_FLOAT_PRECISION)
+            precision = MAX_FLOAT_PRECISION;
+        double value = FetchFloat(Args);
+        negative = (value < 0.0);
+        length = ConvertFloat(conversion, negative ? -value : value, precision, fs->format);
+        digits = length;
+    }
+    else {
+        uint64_t high, low;
+        uint32_t base = (fs->format == 'o') ? 8 : (fs->format == 'x' || fs->format == 'X') ? 16 : 10;
+        FetchInteger(fs, Args, &high, &low, &negative);
+        length = ConvertUnsigned(conversion, high, low, base, fs->format == 'X');
+        digits = (fs->hasPrecision && (size_t)fs->precision > length) ? (size_t)fs->precision : length;
+    }
+
+    size_t field = digits + (negative ? 1 : 0);
+    size_t padding = ((size_t)fs->width > field) ? fs->width - field : 0;
+
+    if (!fs->padZero)
+        AppendRepeat(Out, ' ', padding);
+    if (negative)
+        AppendRepeat(Out, '-', 1);
+    if (fs->padZero)
+        AppendRepeat(Out, '0', padding);
+    AppendRepeat(Out, '0', digits - length);
+    AppendNarrow(Out, conversion, length);
+}
+
+/// @brief Formats `Format`, which may be either a narrow or a CHAR16 string, directly into the CHAR16 output
+///        sink `Out`. Literal runs of a narrow format string are widened in bulk by `WidenAscii` rather than
+///        being converted in a separate pass. Supports the specifiers recognized by `ParseSpecifier`.
+/// @param Out    the output sink; its buffer, if it has one, is NUL-terminated on return
+/// @param Format the format string
+/// @param IsWide whether `Format` is a CHAR16 string
+/// @param Args   the source of the arguments referenced by the format specifiers
+/// @return       the first error returned by `Flush`, if any; otherwise `EFI_BUFFER_TOO_SMALL` if output was
+///               truncated, or `EFI_SUCCESS`
+static EFI_STATUS FormatWithArguments(struct PrintBuffer *Out, const void *Format, bool IsWide,
+                                      struct FormatArguments *Args)
+{
+    struct FormatSpecifier fs;
+    size_t index = 0;
+
+    for (;;) {
+        size_t start = index;
+        CHAR16 c;
+        while ((c = FormatCharAt(Format, IsWide, index)) != 0 && c != '%')
+            index++;
+
+        if (index > start) {
+            if (IsWide)
+                AppendWide(Out, (const CHAR16 *)Format + start, index - start);
+            else
+                AppendNarrow(Out, (const char *)Format + start, index - start);
+        }
+        if (c == 0)
+            break;
+
+        index++;
+        if (!ParseSpecifier(Format, IsWide, &index, &fs))
+            break;
+
+        if (fs.format == '%')
+            AppendRepeat(Out, '%', 1);
+        else if (fs.format == 's')
+            EmitString(Out, &fs, IsWide, Args);
+        else
+            EmitNumber(Out, &fs, Args);
+    }
+
+    if (Out->Buffer != NULL)
+        Out->Buffer[Out->Length] = 0;
+    if (EFI_ERROR(Out->Status))
+        return Out->Status;
+    return (Out->Length < Out->Total && Out->Flush == NULL) ? EFI_BUFFER_TOO_SMALL : EFI_SUCCESS;
+}
+
+/// @brief Formats `Format` with arguments taken from a variadic argument list. See `FormatWithArguments`.
+EFI_STATUS FormatString(struct PrintBuffer *Out, const void *Format, bool IsWide, va_list Args)
+{
+    struct FormatArguments args = { .Words = NULL };
+    va_copy(args.List, Args);
+    EFI_STATUS status = FormatWithArguments(Out, Format, IsWide, &args);
+    va_end(args.List);
+    return status;
+}
+
+/// @brief Formats `Format` with arguments taken from the packed words of a deferred log record, as stored by
+///        `BootLog`. See `FormatWithArguments` and `FetchInteger` for how the words are interpreted.
+EFI_STATUS FormatRecord(struct PrintBuffer *Out, const void *Format, bool IsWide, const UINT64 *Words,
+                        size_t Count)
+{
+    struct FormatArguments args = { .Words = Words, .Count = Count, .Index = 0 };
+    return FormatWithArguments(Out, Format, IsWide, &args);
+}
+
+/// @brief Describes how the packed argument words of a deferred record are used by its format string, so
+///        that string arguments can be located without rendering the record. Each word is classified as a
+///        narrow string pointer (`s`), a CHAR16 string pointer (`S`) or a plain value (`v`).
+/// @param Format the format string
+/// @param IsWide whether `Format` is a CHAR16 string
+/// @param Kinds  receives one classification character per argument word
+/// @param Max    the number of elements in `Kinds`
+/// @return       the number of argument words the format string consumes (which may exceed `Max`)
+size_t ClassifyArguments(const void *Format, bool IsWide, char *Kinds, size_t Max)
+{
+    struct FormatSpecifier fs;
+    size_t index = 0, count = 0;
+    CHAR16 c;
+
+    while ((c = FormatCharAt(Format, IsWide, index++)) != 0) {
+        if (c != '%')
+            continue;
+        if (!ParseSpecifier(Format, IsWide, &index, &fs))
+            break;
+        if (fs.format == '%')
+            continue;
+
+        char kind = 'v';
+        if (fs.format == 's')
+            kind = ((fs.modifier == 'l') || (IsWide && fs.modifier != 'h')) ? 'S' : 's';
+        for (int i = (fs.format != 's' && fs.modifier == 'q') ? 2 : 1; i > 0; i--, count++) {
+            if (count < Max)
+                Kinds[count] = kind;
+        }
+    }
+    return count;
+}
+
+/// @brief Formats a narrow format string into the CHAR16 buffer `Buffer`, truncating if necessary.
+/// @param Buffer the destination buffer
+/// @param Count  the size of `Buffer` in CHAR16 elements, including the terminating NUL; if 0, nothing is
+///               written and `Buffer` may be `NULL`
+/// @param Format the format string
+/// @param ...    a vararg list to inject into `Format` in accordance with the format specifiers
+/// @return       the number of characters the complete output requires, excluding the terminating NUL
+size_t PrintToBufferNarrow(CHAR16 *Buffer, size_t Count, const char *Format, ...)
+{
+    struct PrintBuffer out = { (Count > 0) ? Buffer : NULL, (Count > 0) ? Count - 1 : 0, 0, 0, NULL };
+    va_list args;
+    va_start(args, Format);
+    FormatString(&out, Format, false, args);
+    va_end(args);
+    return out.Total;
+}
+
+/// @brief Formats a CHAR16 format string into the CHAR16 buffer `Buffer`, truncating if necessary.
+/// @param Buffer the destination buffer
+/// @param Count  the size of `Buffer` in CHAR16 elements, including the terminating NUL; if 0, nothing is
+///               written and `Buffer` may be `NULL`
+/// @param Format the format string
+/// @param ...    a vararg list to inject into `Format` in accordance with the format specifiers
+/// @return       the number of characters the complete output requires, excluding the terminating NUL
+size_t PrintToBufferWide(CHAR16 *Buffer, size_t Count, const CHAR16 *Format, ...)
+{
+    struct PrintBuffer out = { (Count > 0) ? Buffer : NULL, (Count > 0) ? Count - 1 : 0, 0, 0, NULL };
+    va_list args;
+    va_start(args, Format);
+    FormatString(&out, Format, true, args);
+    va_end(args);
+    return out.Total;
+}
+
+/// @brief Formats a narrow format string and writes the result to the console. Output is accumulated in a
+///        fixed CHAR16 buffer on the stack, which is flushed to the console whenever it fills.
+/// @param Format the formatted string to substitute and print
+/// @param ...    a vararg list to inject into `Format` in accordance with the format specifiers
+/// @return       the first error returned by the console while writing the output, or `EFI_SUCCESS`
+EFI_STATUS PrintNarrow(const char *Format, ...)
+{
+    CHAR16 buffer[PRINT_BUFFER_LENGTH + 1];
+    struct PrintBuffer out = { buffer, PRINT_BUFFER_LENGTH, 0, 0, ConsoleOutput };
+    va_list args;
+    va_start(args, Format);
+    EFI_STATUS status = FormatString(&out, Format, false, args);
+    va_end(args);
+    EFI_STATUS flushed = ConsoleOutput(buffer);
+    return EFI_ERROR(status) ? status : flushed;
+}
+
+/// @brief Formats a CHAR16 format string and writes the result to the console. See `PrintNarrow`.
+/// @param Format the formatted string to substitute and print
+/// @param ...    a vararg list to inject into `Format` in accordance with the format specifiers
+/// @return       the first error returned by the console while writing the output, or `EFI_SUCCESS`
+EFI_STATUS PrintWide(const CHAR16 *Format, ...)
+{
+    CHAR16 buffer[PRINT_BUFFER_LENGTH + 1];
+    struct PrintBuffer out = { buffer, PRINT_BUFFER_LENGTH, 0, 0, ConsoleOutput };
+    va_list args;
+    va_start(args, Format);
+    EFI_STATUS status = FormatString(&out, Format, true, args);
+    va_end(args);
+    EFI_STATUS flushed = ConsoleOutput(buffer);
+    return EFI_ERROR(status) ? status : flushed;
+}
+
+/// @brief Renders a deferred log record into the CHAR16 buffer `Buffer`, truncating if necessary.
+/// @param Buffer    the destination buffer
+/// @param Count     the size of `Buffer` in CHAR16 elements, including the terminating NUL; if 0, nothing
+///                  is written and `Buffer` may be `NULL`
+/// @param Format    the record's format string
+/// @param IsWide    whether `Format` is a CHAR16 string
+/// @param Words     the record's packed argument words
+/// @param WordCount the number of argument words
+/// @return          the number of characters the complete output requires, excluding the terminating NUL
+size_t PrintRecordToBuffer(CHAR16 *Buffer, size_t Count, const void *Format, bool IsWide, const UINT64 *Words,
+                           size_t WordCount)
+{
+    struct PrintBuffer out = { (Count > 0) ? Buffer : NULL, (Count > 0) ? Count - 1 : 0, 0, 0, NULL };
+    FormatRecord(&out, Format, IsWide, Words, WordCount);
+    return out.Total;
+}
+
+/// @brief Renders a deferred log record to the console. See `PrintNarrow`.
+/// @param Format    the record's format string
+/// @param IsWide    whether `Format` is a CHAR16 string
+/// @param Words     the record's packed argument words
+/// @param WordCount the number of argument words
+/// @return          the first error returned by the console while writing the output, or `EFI_SUCCESS`
+EFI_STATUS PrintRecord(const void *Format, bool IsWide, const UINT64 *Words, size_t WordCount)
+{
+    CHAR16 buffer[PRINT_BUFFER_LENGTH + 1];
+    struct PrintBuffer out = { buffer, PRINT_BUFFER_LENGTH, 0, 0, ConsoleOutput };
+    EFI_STATUS status = FormatRecord(&out, Format, IsWide, Words, WordCount);
+    EFI_STATUS flushed = ConsoleOutput(buffer);
+    return EFI_ERROR(status) ? status : flushed;
+}
@@ -7,7 +7,7 @@
 // Project     : Shasta Microkernel                                                                         //
 // Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
 // Created     : August 29, 2023                                                                            //
-// Modified    : August 29, 2023                                                                            //
+// Modified    : October 19, 2026                                                                           //
 // Version     : 0.0.0                                                                                      //
 // License     : GNU General Public License (GPL) version 3.0                                               //
 // Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
@@ -35,9 +35,31 @@
 #ifndef UEFI_FUNCTIONS_H
 #define UEFI_FUNCTIONS_H
 
-void        InitializeLib   (EFI_HANDLE, EFI_SYSTEM_TABLE *);
-EFI_STATUS  AllocatePool    (EFI_MEMORY_TYPE, UINTN, VOID **);
-EFI_STATUS  FreePool        (VOID *);
-EFI_STATUS  Print           (const char *, ...);
+void        UefiInitializeLib   (EFI_HANDLE, EFI_SYSTEM_TABLE *);
+EFI_STATUS  UefiAllocatePool    (EFI_MEMORY_TYPE, UINTN, VOID **);
+EFI_STATUS  UefiFreePool        (VOID *);
+EFI_STATUS  UefiGetVariable     (CHAR16 *, EFI_GUID *, UINT32 *, UINTN *, VOID *);
+EFI_STATUS  UefiSetVariable     (CHAR16 *, EFI_GUID *, UINT32, UINTN, VOID *);
+size_t      PrintToBufferNarrow (CHAR16 *, size_t, const char *, ...);
+size_t      PrintToBufferWide   (CHAR16 *, size_t, const CHAR16 *, ...);
+EFI_STATUS  PrintNarrow         (const char *, ...);
+EFI_STATUS  PrintWide           (const CHAR16 *, ...);
+size_t      PrintRecordToBuffer (CHAR16 *, size_t, const void *, bool, const UINT64 *, size_t);
+EFI_STATUS  PrintRecord         (const void *, bool, const UINT64 *, size_t);
+size_t      ClassifyArguments   (const void *, bool, char *, size_t);
+
+// Dispatches on the width of the format string, so that both `Print("...")` and `Print(L"...")` emit CHAR16
+// output directly without an intermediate conversion pass.
+#define Print(Format, ...)                                                                                   \
+    _Generic((Format), char *         : PrintNarrow,                                                         \
+                       const char *   : PrintNarrow,                                                         \
+                       CHAR16 *       : PrintWide,                                                           \
+                       const CHAR16 * : PrintWide)((Format), ##__VA_ARGS__)
+
+#define PrintToBuffer(Buffer, Count, Format, ...)                                                            \
+    _Generic((Format), char *         : PrintToBufferNarrow,                                                 \
+                       const char *   : PrintToBufferNarrow,                                                 \
+                       CHAR16 *       : PrintToBufferWide,                                                   \
+                       const CHAR16 * : PrintToBufferWide)((Buffer), (Count), (Format), ##__VA_ARGS__)
 
 #endif /* UEFI_FUNCTIONS_H */
\ No newline at end of file
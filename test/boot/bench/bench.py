@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+# ---------------------------------------------------------------------------------------------------------- #
+# Boots the bootloader under QEMU and OVMF a number of times and reports the time taken to reach the kernel  #
+# handoff, read from the stage markers the bootloader writes to the debug console (src/boot/bootstage.h).    #
+#                                                                                                            #
+# Two clocks are reported for each stage:                                                                    #
+#   host    time from launching QEMU until the marker arrives, which includes QEMU and firmware start-up     #
+#   guest   the timestamp counter in the marker, which starts from zero when the virtual machine is reset    #
+#                                                                                                            #
+# A configuration boots from its own copy of the OVMF variable store. By default one warm-up boot, which     #
+# fills the firmware's boot options, is run and discarded first; with --cold every boot starts from a fresh  #
+# copy of the store instead. The kernel is placed on the boot volume, so the kernel location cache is not    #
+# consulted and the "cache" stage is not reported.                                                           #
+#                                                                                                            #
+# The p99 column is only reported for more than 100 runs; with fewer it would simply be the maximum.         #
+# ---------------------------------------------------------------------------------------------------------- #
+
+import argparse
+import json
+import os
+import random
+import re
+import selectors
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+STAGES = ["entry", "cache", "loaded", "handoff"]
+P99_MIN_RUNS = 101
+STAGE_LINE = re.compile(rb"^shasta: stage (\S+) tsc ([0-9a-f]+)$")
+HZ_LINE = re.compile(rb"^shasta: tsc-hz ([0-9]+)$")
+KERNEL_PATH = ("shasta", "kernel.elf")
+LOADER_PATH = ("EFI", "BOOT", "BOOTX64.EFI")
+
+
+# The medians --limit can be applied to. "loader" is the bootloader's own time, from efi_main to the handoff
+# marker on the guest clock, and excludes QEMU and firmware start-up; "handoff" is the end-to-end host time.
+LIMIT_METRICS = {
+    "loader": ("bootloader time, entry to handoff", lambda summary: summary.get("loader", {}).get("p50")),
+    "handoff": ("host time to handoff", lambda summary: summary["handoff"]["host"]["p50"]),
+}
+
+
+class BootFailure(Exception):
+    pass
+
+
+def parse_size(text):
+    """Parses a byte count with an optional K, M or G suffix."""
+    units = {"K": 1 << 10, "M": 1 << 20, "G": 1 << 30}
+    text = text.strip().upper()
+    if text and text[-1] in units:
+        return int(text[:-1]) * units[text[-1]]
+    return int(text)
+
+
+def format_size(size):
+    for unit, scale in (("GiB", 1 << 30), ("MiB", 1 << 20), ("KiB", 1 << 10)):
+        if size >= scale and size % scale == 0:
+            return "%d %s" % (size // scale, unit)
+    return "%d B" % size
+
+
+def percentile(values, percent):
+    """Nearest-rank percentile, matching the statistics reported by test/boot/sim."""
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, (len(ordered) * percent) // 100)]
+
+
+def make_esp(root, loader, kernel, kernel_size):
+    """Lays out an EFI system partition under root with the bootloader and a kernel. Without a kernel file, a
+    kernel of kernel_size pseudo-random bytes is generated from a fixed seed so that runs are repeatable."""
+    os.makedirs(os.path.join(root, *LOADER_PATH[:-1]), exist_ok=True)
+    os.makedirs(os.path.join(root, *KERNEL_PATH[:-1]), exist_ok=True)
+    shutil.copyfile(loader, os.path.join(root, *LOADER_PATH))
+    if kernel:
+        shutil.copyfile(kernel, os.path.join(root, *KERNEL_PATH))
+    else:
+        with open(os.path.join(root, *KERNEL_PATH), "wb") as file:
+            file.write(random.Random(kernel_size).randbytes(kernel_size))
+
+
+def qemu_command(args, config, esp, variables):
+    return [
+        args.qemu,
+        "-machine", "q35,accel=%s" % args.accel,
+        "-m", str(config["memory"]),
+        "-smp", str(config["cpus"]),
+        "-nodefaults", "-display", "none", "-no-reboot",
+        "-drive", "if=pflash,format=raw,unit=0,readonly=on,file=%s" % args.ovmf_code,
+        "-drive", "if=pflash,format=raw,unit=1,file=%s" % variables,
+        "-drive", "format=raw,file=fat:%s" % esp,
+        "-debugcon", "stdio", "-global", "isa-debugcon.iobase=0xe9",
+    ]
+
+
+def boot_once(args, config, esp, variables):
+    """Boots the virtual machine until the handoff marker and the counter frequency have been reported, and
+    returns the host and guest time of each stage in milliseconds."""
+    markers = {}
+    hz = None
+    pending = b""
+    errors = tempfile.TemporaryFile()
+    start = time.monotonic()
+    process = subprocess.Popen(qemu_command(args, config, esp, variables), stdin=subprocess.DEVNULL,
+                               stdout=subprocess.PIPE, stderr=errors)
+    selector = selectors.DefaultSelector()
+    selector.register(process.stdout, selectors.EVENT_READ)
+    try:
+        while hz is None:
+            remaining = start + args.timeout - time.monotonic()
+            if remaining <= 0:
+                raise BootFailure("timed out after %.0f s (stages seen: %s)" %
+                                  (args.timeout, ", ".join(markers) or "none"))
+            if not selector.select(remaining):
+                continue
+            chunk = os.read(process.stdout.fileno(), 4096)
+            now = time.monotonic()
+            if not chunk:
+                process.wait()
+                errors.seek(0)
+                error = errors.read().decode(errors="replace").strip()
+                raise BootFailure("QEMU exited with status %s%s" %
+                                  (process.returncode, (": " + error) if error else ""))
+            pending += chunk
+            *lines, pending = pending.split(b"\n")
+            for line in lines:
+                line = line.rstrip(b"\r")
+                stage = STAGE_LINE.match(line)
+                if stage:
+                    markers[stage.group(1).decode()] = ((now - start) * 1000, int(stage.group(2), 16))
+                elif HZ_LINE.match(line):
+                    hz = int(HZ_LINE.match(line).group(1))
+    finally:
+        selector.close()
+        process.kill()
+        process.wait()
+        errors.close()
+
+    if "handoff" not in markers:
+        raise BootFailure("counter frequency reported before the handoff marker")
+    return {name: {"host": host, "guest": tsc * 1000 / hz} for name, (host, tsc) in markers.items()}
+
+
+def run_configuration(args, config):
+    """Boots one configuration args.runs times and returns the individual runs and their summary."""
+    with tempfile.TemporaryDirectory(prefix="shasta-bench-") as scratch:
+        esp = os.path.join(scratch, "esp")
+        variables = os.path.join(scratch, "OVMF_VARS.fd")
+        make_esp(esp, args.efi, args.kernel, config["kernel_size"])
+        shutil.copyfile(args.ovmf_vars, variables)
+        if not args.cold:
+            boot_once(args, config, esp, variables)
+
+        runs = []
+        for _ in range(args.runs):
+            if args.cold:
+                shutil.copyfile(args.ovmf_vars, variables)
+            runs.append(boot_once(args, config, esp, variables))
+
+    summary = {}
+    for stage in STAGES:
+        seen = [run[stage] for run in runs if stage in run]
+        if not seen:
+            continue
+        summary[stage] = {}
+        for clock in ("host", "guest"):
+            values = [marker[clock] for marker in seen]
+            stats = {"min": min(values), "p50": percentile(values, 50), "p90": percentile(values, 90),
+                     "max": max(values)}
+            if len(values) >= P99_MIN_RUNS:
+                stats["p99"] = percentile(values, 99)
+            summary[stage][clock] = stats
+    loader = [run["handoff"]["guest"] - run["entry"]["guest"] for run in runs if "entry" in run]
+    if loader:
+        summary["loader"] = {"p50": percentile(loader, 50), "p90": percentile(loader, 90)}
+    return {"config": config, "runs": runs, "summary": summary}
+
+
+def describe(args, config):
+    return "%s, %d CPU(s), %s kernel, %s, %s" % (
+        format_size(config["memory"] << 20), config["cpus"],
+        "given" if args.kernel else format_size(config["kernel_size"]), args.accel,
+        "cold" if args.cold else "warm")
+
+
+def report(args, result):
+    summary = result["summary"]
+    columns = ["min", "p50", "p90"] + (["p99"] if len(result["runs"]) >= P99_MIN_RUNS else []) + ["max"]
+    print("%d boots: %s" % (len(result["runs"]), describe(args, result["config"])))
+    print("    %-16s" % "time to" + "".join(" %10s" % column for column in columns))
+    for stage in STAGES:
+        for clock in ("host", "guest"):
+            if stage in summary:
+                stats = summary[stage][clock]
+                print("    %-16s" % ("%s (%s)" % (stage, clock) if clock == "host" else "  (guest)") +
+                      "".join(" %10.3f" % stats[column] for column in columns) + " ms")
+    if "loader" in summary:
+        print("    bootloader, entry to handoff: p50 %.3f ms, p90 %.3f ms" %
+              (summary["loader"]["p50"], summary["loader"]["p90"]))
+
+
+def sweep(args, base, key, values, label):
+    """Boots the base configuration with key set to each of values and reports how time to kernel scales."""
+    results = []
+    print("sweep over %s:" % label)
+    print("    %-12s %12s %12s %12s %12s" % (label, "host p50", "host p90", "guest p50", "loader p50"))
+    for value in values:
+        config = dict(base, **{key: value})
+        result = run_configuration(args, config)
+        summary = result["summary"]
+        shown = format_size(value) if key == "kernel_size" else \
+            format_size(value << 20) if key == "memory" else str(value)
+        print("    %-12s %9.3f ms %9.3f ms %9.3f ms %9.3f ms" % (
+            shown, summary["handoff"]["host"]["p50"], summary["handoff"]["host"]["p90"],
+            summary["handoff"]["guest"]["p50"], summary.get("loader", {}).get("p50", float("nan"))))
+        results.append(result)
+    return results
+
+
+def size_list(text):
+    return [parse_size(item) for item in text.split(",") if item]
+
+
+def int_list(text):
+    return [int(item) for item in text.split(",") if item]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measures time to kernel handoff under QEMU and OVMF.")
+    parser.add_argument("--efi", required=True, help="bootloader built with STAGE_MARKERS=1")
+    parser.add_argument("--ovmf-code", required=True, help="OVMF firmware code volume")
+    parser.add_argument("--ovmf-vars", required=True, help="OVMF variable store template")
+    parser.add_argument("--qemu", default="qemu-system-x86_64")
+    parser.add_argument("--accel", default="kvm" if os.access("/dev/kvm", os.R_OK | os.W_OK) else "tcg")
+    parser.add_argument("--runs", type=int, default=20, help="measured boots per configuration")
+    parser.add_argument("--memory", type=int, default=512, help="guest memory in MiB")
+    parser.add_argument("--cpus", type=int, default=2)
+    parser.add_argument("--kernel", help="kernel to boot instead of a generated one")
+    parser.add_argument("--kernel-size", type=parse_size, default=parse_size("4M"),
+                        help="size of the generated kernel")
+    parser.add_argument("--cold", action="store_true", help="boot every run from a fresh variable store")
+    parser.add_argument("--timeout", type=float, default=60, help="seconds allowed for one boot")
+    parser.add_argument("--sweep-memory", type=int_list, metavar="MIB,...")
+    parser.add_argument("--sweep-cpus", type=int_list, metavar="N,...")
+    parser.add_argument("--sweep-kernel-size", type=size_list, metavar="SIZE,...")
+    parser.add_argument("--limit", type=float, metavar="MS",
+                        help="fail if the median of the --limit-metric exceeds this")
+    parser.add_argument("--limit-metric", choices=sorted(LIMIT_METRICS), default="loader",
+                        help="what --limit applies to (default: loader)")
+    parser.add_argument("--json", metavar="FILE", help="also write every run and summary to FILE")
+    args = parser.parse_args()
+    if args.runs < 1:
+        parser.error("--runs must be at least 1")
+    for path in (args.efi, args.ovmf_code, args.ovmf_vars, args.kernel):
+        if path is not None and not os.path.isfile(path):
+            parser.error("%s: no such file" % (path or "(empty path)"))
+
+    base = {"memory": args.memory, "cpus": args.cpus, "kernel_size": args.kernel_size}
+    output = {}
+    try:
+        output["baseline"] = run_configuration(args, base)
+        report(args, output["baseline"])
+        sweeps = [("memory", args.sweep_memory, "memory"), ("cpus", args.sweep_cpus, "CPUs"),
+                  ("kernel_size", None if args.kernel else args.sweep_kernel_size, "kernel size")]
+        for key, values, label in sweeps:
+            if values:
+                output["sweep_" + key] = sweep(args, base, key, values, label)
+    except BootFailure as failure:
+        print("bench: boot failed: %s" % failure, file=sys.stderr)
+        return 1
+
+    if args.json:
+        with open(args.json, "w") as file:
+            json.dump(output, file, indent=2)
+
+    if args.limit is not None:
+        label, select = LIMIT_METRICS[args.limit_metric]
+        median = select(output["baseline"]["summary"])
+        if median is None:
+            print("bench: no %s was measured to check against the limit" % label, file=sys.stderr)
+            return 1
+        if median > args.limit:
+            print("bench: median %s %.3f ms exceeds the limit of %.3f ms" % (label, median, args.limit),
+                  file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,145 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Main File, Kernel Location Cache Tests, UEFI Bootloader Test Suite                         //
+// Filename    : main.c                                                                                     //
+// Description : Provides the main program file for the test of the kernel location cache incorporated into //
+//               Shasta's UEFI bootloader. Builds against the bootloader's kernelcache.c and uefiutil.c,    //
+//               with the variable store from the UEFI simulator in ../sim.                                 //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "uefi_sim.h"
+#include "kernelcache.h"
+#include "uefiutil.h"
+
+bool SimQuiet;
+
+static EFI_GUID CacheGuid = KERNEL_CACHE_GUID;
+
+/// Reports the result of a single check.
+///
+/// @param Name      a short description of the case under test
+/// @param Condition whether the check passed
+/// @return          1 if the check failed, 0 otherwise
+static int Check(const char *Name, bool Condition)
+{
+    printf("    %-48s %s\n", Name, Condition ? "PASS" : "FAIL");
+    return Condition ? 0 : 1;
+}
+
+/// Builds a cache record describing a single kernel file of the given size.
+///
+/// @param Cache the record to fill in
+/// @param Size  the size of the kernel file
+static void BuildCache(struct KernelCache *Cache, UINTN Size)
+{
+    const CHAR16 path[] = u"\\shasta\\kernel.elf";
+
+    memset(Cache, 0, sizeof(*Cache));
+    for (UINTN i = 0; i < 4; i++)
+        Cache->DevicePath[i] = (UINT8)(0x10 + i);
+    Cache->DevicePath[4] = 0x7F;
+    Cache->DevicePath[5] = 0xFF;
+    Cache->DevicePath[6] = 0x04;
+    Cache->DevicePathSize = 8;
+    memcpy(Cache->Files[0].Path, path, sizeof(path));
+    Cache->Files[0].Size = Size;
+    Cache->FileCount = 1;
+}
+
+/// Flips one bit of the stored cache record, bypassing `StoreKernelCache`.
+///
+/// @param Offset the byte of the record to alter
+static void FlipStoredBit(UINTN Offset)
+{
+    struct KernelCache stored;
+    UINTN size = sizeof(stored);
+
+    UefiGetVariable(KERNEL_CACHE_VARIABLE, &CacheGuid, NULL, &size, &stored);
+    ((UINT8 *)&stored)[Offset] ^= 0x01;
+    UefiSetVariable(KERNEL_CACHE_VARIABLE, &CacheGuid, KERNEL_CACHE_ATTRIBUTES, size, &stored);
+}
+
+int main()
+{
+    EFI_SYSTEM_TABLE systemTable = { 0 };
+    EFI_RUNTIME_SERVICES runtimeServices;
+    struct KernelCache cache, loaded;
+    UINTN writes;
+    int failures = 0;
+
+    InitializeRuntimeServices(&runtimeServices, NULL);
+    systemTable.RuntimeServices = &runtimeServices;
+    UefiInitializeLib(NULL, &systemTable);
+
+    printf("Kernel location cache:\n");
+
+    failures += Check("empty store reports EFI_NOT_FOUND", LoadKernelCache(&loaded) == EFI_NOT_FOUND);
+
+    BuildCache(&cache, 2500);
+    writes = VariableWrites();
+    failures += Check("store succeeds", StoreKernelCache(&cache) == EFI_SUCCESS);
+    failures += Check("store writes the variable once", VariableWrites() - writes == 1);
+    failures += Check("load succeeds", LoadKernelCache(&loaded) == EFI_SUCCESS);
+    failures += Check("loaded record matches stored record", memcmp(&loaded, &cache, sizeof(cache)) == 0);
+
+    writes = VariableWrites();
+    failures += Check("identical store succeeds", StoreKernelCache(&cache) == EFI_SUCCESS);
+    failures += Check("identical store skips the NVRAM write", VariableWrites() == writes);
+
+    cache.Files[0].Size++;
+    failures += Check("changed store succeeds", StoreKernelCache(&cache) == EFI_SUCCESS);
+    failures += Check("changed store rewrites the variable", VariableWrites() - writes == 1);
+    cache.Files[0].Size--;
+    StoreKernelCache(&cache);
+
+    FlipStoredBit(300);
+    failures += Check("corrupted record is rejected", LoadKernelCache(&loaded) == EFI_VOLUME_CORRUPTED);
+    FlipStoredBit(300);
+
+    for (UINTN i = 0; i < KERNEL_CACHE_MAX_PATH; i++)
+        cache.Files[0].Path[i] = u'x';
+    StoreKernelCache(&cache);
+    failures += Check("unterminated path is rejected", LoadKernelCache(&loaded) == EFI_VOLUME_CORRUPTED);
+    BuildCache(&cache, 2500);
+    StoreKernelCache(&cache);
+
+    cache.Version = KERNEL_CACHE_VERSION + 1;
+    cache.Checksum = KernelCacheChecksum(&cache);
+    UefiSetVariable(KERNEL_CACHE_VARIABLE, &CacheGuid, KERNEL_CACHE_ATTRIBUTES, sizeof(cache), &cache);
+    failures += Check("other record version is rejected",
+                      LoadKernelCache(&loaded) == EFI_INCOMPATIBLE_VERSION);
+
+    UefiSetVariable(KERNEL_CACHE_VARIABLE, &CacheGuid, KERNEL_CACHE_ATTRIBUTES, 16, &cache);
+    failures += Check("short record is rejected", LoadKernelCache(&loaded) == EFI_VOLUME_CORRUPTED);
+
+    failures += Check("invalidate succeeds", InvalidateKernelCache() == EFI_SUCCESS);
+    failures += Check("invalidated cache reports EFI_NOT_FOUND", LoadKernelCache(&loaded) == EFI_NOT_FOUND);
+    failures += Check("invalidating twice succeeds", InvalidateKernelCache() == EFI_SUCCESS);
+
+    printf("%d failure(s)\n", failures);
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
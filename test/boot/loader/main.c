@@ -0,0 +1,290 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Test Driver, Kernel Loader Tests, UEFI Bootloader Test Suite                               //
+// Filename    : main.c                                                                                     //
+// Description : Runs LoadKernel against the UEFI simulator across a series of boots to check that the      //
+//               kernel location cache is used when it is valid, and that a stale, corrupt or missing cache //
+//               falls back to the full lookup and is rewritten.                                            //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "uefi_sim.h"
+#include "kernelcache.h"
+#include "loader.h"
+#include "bootlog.h"
+#include "uefiutil.h"
+
+bool SimQuiet = true;
+
+static EFI_SYSTEM_TABLE     SystemTable;
+static EFI_BOOT_SERVICES    BootServices;
+static EFI_RUNTIME_SERVICES RuntimeServices;
+static EFI_LOADED_IMAGE     LoadedImage;
+static EFI_HANDLE           Image;
+static char                 Scratch[] = "/tmp/shasta-loader-XXXXXX";
+
+// The outcome of one simulated boot.
+struct Boot {
+    EFI_STATUS        Status;
+    UINTN             Size;
+    enum KernelSource Source;
+    UINTN             Writes;
+};
+
+/// Reports the result of a single check.
+///
+/// @param Name      a short description of the case under test
+/// @param Condition whether the check passed
+/// @return          1 if the check failed, 0 otherwise
+static int Check(const char *Name, bool Condition)
+{
+    printf("    %-48s %s\n", Name, Condition ? "PASS" : "FAIL");
+    return Condition ? 0 : 1;
+}
+
+/// Returns the host path of `Name` under the scratch directory.
+static const char *ScratchPath(const char *Name)
+{
+    static char path[256];
+    snprintf(path, sizeof(path), "%s/%s", Scratch, Name);
+    return path;
+}
+
+/// Writes a kernel of `Size` bytes to the volume directory `Volume`, or removes it if `Size` is zero.
+///
+/// @param Volume the volume directory under the scratch directory
+/// @param Size   the size of the kernel to write
+static void PlaceKernel(const char *Volume, UINTN Size)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s/shasta/kernel.elf", Scratch, Volume);
+    if (Size == 0) {
+        unlink(path);
+        return;
+    }
+
+    FILE *file = fopen(path, "wb");
+    for (UINTN i = 0; i < Size; i++)
+        fputc((int)(i * 7 + 3) & 0xFF, file);
+    fclose(file);
+}
+
+/// Creates a volume directory with an empty `\shasta` directory and exposes it to the firmware.
+///
+/// @param Volume the volume directory under the scratch directory
+/// @return       the handle of the new volume
+static EFI_HANDLE MakeVolume(const char *Volume)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", Scratch, Volume);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/%s/shasta", Scratch, Volume);
+    mkdir(path, 0755);
+    return CreateVolume(&BootServices, ScratchPath(Volume));
+}
+
+/// Removes the volume directories and the scratch directory. Every kernel must already have been removed.
+static void RemoveScratch(void)
+{
+    const char *volumes[] = { "boot", "data", "spare" };
+    char path[256];
+
+    for (UINTN i = 0; i < sizeof(volumes) / sizeof(volumes[0]); i++) {
+        snprintf(path, sizeof(path), "%s/%s/shasta", Scratch, volumes[i]);
+        rmdir(path);
+        rmdir(ScratchPath(volumes[i]));
+    }
+    rmdir(Scratch);
+}
+
+/// Runs `LoadKernel` once as a freshly started image would, then releases everything it allocated.
+static struct Boot RunBoot(void)
+{
+    struct KernelImage kernel;
+    struct Boot boot = { 0 };
+    UINTN writes = VariableWrites();
+
+    BeginImage();
+    UefiInitializeLib(Image, &SystemTable);
+    BootLogInitialize();
+    boot.Status = LoadKernel(Image, &SystemTable, &kernel);
+    if (!EFI_ERROR(boot.Status)) {
+        boot.Size = kernel.Size;
+        boot.Source = kernel.Source;
+    }
+    boot.Writes = VariableWrites() - writes;
+    ResetBootServices();
+    return boot;
+}
+
+/// Reads the simulated memory map and checks it against a set of allocations.
+///
+/// @param Allocations addresses which must each lie within a descriptor other than conventional memory
+/// @param Count       the number of addresses in `Allocations`
+/// @param Ordered     receives whether the descriptors are sorted by address and never overlap
+/// @param Described   receives whether every address in `Allocations` is described
+static void InspectMemoryMap(UINT64 *Allocations, UINTN Count, bool *Ordered, bool *Described)
+{
+    UINTN size = 0, key, stride;
+    UINT32 version;
+    UINT8 *map = NULL;
+    EFI_STATUS status;
+
+    for (;;) {
+        status = BootServices.GetMemoryMap(&size, (EFI_MEMORY_DESCRIPTOR *)map, &key, &stride, &version);
+        if (status != EFI_BUFFER_TOO_SMALL)
+            break;
+        free(map);
+        map = malloc(size);
+    }
+    *Ordered = *Described = !EFI_ERROR(status);
+    if (EFI_ERROR(status)) {
+        free(map);
+        return;
+    }
+
+    for (UINTN offset = stride; offset < size; offset += stride) {
+        EFI_MEMORY_DESCRIPTOR *previous = (EFI_MEMORY_DESCRIPTOR *)(map + offset - stride);
+        EFI_MEMORY_DESCRIPTOR *current = (EFI_MEMORY_DESCRIPTOR *)(map + offset);
+        if (previous->PhysicalStart + previous->NumberOfPages * EFI_PAGE_SIZE > current->PhysicalStart)
+            *Ordered = false;
+    }
+
+    for (UINTN i = 0; i < Count; i++) {
+        bool found = false;
+        for (UINTN offset = 0; offset < size && !found; offset += stride) {
+            EFI_MEMORY_DESCRIPTOR *d = (EFI_MEMORY_DESCRIPTOR *)(map + offset);
+            found = (d->Type != EfiConventionalMemory && Allocations[i] >= d->PhysicalStart &&
+                     Allocations[i] < d->PhysicalStart + d->NumberOfPages * EFI_PAGE_SIZE);
+        }
+        if (!found)
+            *Described = false;
+    }
+    free(map);
+}
+
+int main()
+{
+    EFI_GUID loadedImageGuid = EFI_LOADED_IMAGE_PROTOCOL_GUID;
+    EFI_GUID cacheGuid = KERNEL_CACHE_GUID;
+    UINT8 garbage[64] = { 0 };
+    struct Boot boot;
+    int failures = 0;
+
+    if (mkdtemp(Scratch) == NULL) {
+        perror("mkdtemp");
+        return EXIT_FAILURE;
+    }
+
+    InitializeBootServices(&BootServices, 64 << 20);
+    InitializeRuntimeServices(&RuntimeServices, NULL);
+    SystemTable.BootServices = &BootServices;
+    SystemTable.RuntimeServices = &RuntimeServices;
+    InitializeConsole(&SystemTable, "");
+
+    LoadedImage.SystemTable = &SystemTable;
+    LoadedImage.DeviceHandle = MakeVolume("boot");
+    MakeVolume("data");
+    MakeVolume("spare");
+    BootServices.InstallProtocolInterface(&Image, &loadedImageGuid, EFI_NATIVE_INTERFACE, &LoadedImage);
+
+    printf("Kernel loader:\n");
+
+    PlaceKernel("boot", 3000);
+    boot = RunBoot();
+    failures += Check("boot volume kernel is loaded", boot.Status == EFI_SUCCESS && boot.Size == 3000);
+    failures += Check("boot volume kernel bypasses the cache",
+                      boot.Source == KernelSourceBootVolume && boot.Writes == 0);
+    PlaceKernel("boot", 0);
+
+    PlaceKernel("data", 5000);
+    boot = RunBoot();
+    failures += Check("kernel elsewhere is found by full lookup",
+                      boot.Status == EFI_SUCCESS && boot.Source == KernelSourceSearch);
+    failures += Check("full lookup writes the cache", boot.Writes == 1);
+
+    boot = RunBoot();
+    failures += Check("next boot loads through the cache",
+                      boot.Status == EFI_SUCCESS && boot.Source == KernelSourceCache);
+    failures += Check("cached boot reads the whole kernel", boot.Size == 5000);
+    failures += Check("cached boot writes nothing", boot.Writes == 0);
+
+    PlaceKernel("data", 6000);
+    boot = RunBoot();
+    failures += Check("resized kernel falls back to full lookup",
+                      boot.Status == EFI_SUCCESS && boot.Source == KernelSourceSearch && boot.Size == 6000);
+    failures += Check("resized kernel rewrites the cache", boot.Writes == 1);
+    boot = RunBoot();
+    failures += Check("rewritten cache is used on the next boot",
+                      boot.Source == KernelSourceCache && boot.Size == 6000);
+
+    PlaceKernel("data", 0);
+    PlaceKernel("spare", 4000);
+    boot = RunBoot();
+    failures += Check("moved kernel falls back to full lookup",
+                      boot.Status == EFI_SUCCESS && boot.Source == KernelSourceSearch && boot.Size == 4000);
+    failures += Check("moved kernel rewrites the cache", boot.Writes == 1);
+    boot = RunBoot();
+    failures += Check("cache follows the kernel to its new volume",
+                      boot.Source == KernelSourceCache && boot.Size == 4000);
+
+    RuntimeServices.SetVariable(KERNEL_CACHE_VARIABLE, &cacheGuid, KERNEL_CACHE_ATTRIBUTES, sizeof(garbage),
+                                garbage);
+    boot = RunBoot();
+    failures += Check("corrupt cache falls back to full lookup",
+                      boot.Status == EFI_SUCCESS && boot.Source == KernelSourceSearch);
+    failures += Check("corrupt cache is rewritten", boot.Writes == 1);
+
+    PlaceKernel("spare", 0);
+    boot = RunBoot();
+    failures += Check("missing kernel reports EFI_NOT_FOUND", boot.Status == EFI_NOT_FOUND);
+    failures += Check("missing kernel invalidates the cache", boot.Writes == 1);
+    UINTN size = 0;
+    failures += Check("invalidated cache is gone",
+                      RuntimeServices.GetVariable(KERNEL_CACHE_VARIABLE, &cacheGuid, NULL, &size, NULL) ==
+                      EFI_NOT_FOUND);
+    failures += Check("no file handles are left open", OpenFileCount() == 0);
+
+    // Small pools share pages, including with pools of another type; none of them may overlap in the map.
+    printf("Simulated memory map:\n");
+    EFI_MEMORY_TYPE types[] = { EfiLoaderData, EfiLoaderData, EfiBootServicesData, EfiLoaderData };
+    UINT64 allocations[5];
+    BeginImage();
+    for (UINTN i = 0; i < 4; i++)
+        BootServices.AllocatePool(types[i], 64, (VOID **)&allocations[i]);
+    BootServices.AllocatePages(AllocateAnyPages, EfiLoaderData, 2, &allocations[4]);
+    bool ordered, described;
+    InspectMemoryMap(allocations, 5, &ordered, &described);
+    failures += Check("descriptors are sorted and never overlap", ordered);
+    failures += Check("every allocation is described", described);
+    ResetBootServices();
+
+    RemoveScratch();
+
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
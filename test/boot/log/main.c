@@ -0,0 +1,248 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Test Driver, Boot Log Tests, UEFI Bootloader Test Suite                                    //
+// Filename    : main.c                                                                                     //
+// Description : Exercises the deferred boot log: records rendered later must match eager Print output for  //
+//               every specifier, the log must drop rather than overflow when full, and exported images must//
+//               render away from the strings they were made from. Built against the bootloader sources with//
+//               the UEFI simulator in ../sim; see the Makefile.                                            //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "uefi_sim.h"
+#include "boot_log_render.h"
+#include "bootlog.h"
+#include "uefiutil.h"
+
+#define LINE_LENGTH 160
+
+bool SimQuiet;
+
+/// Reports the result of a single check.
+///
+/// @param Name      a short description of the case under test
+/// @param Condition whether the check passed
+/// @return          1 if the check failed, 0 otherwise
+static int Check(const char *Name, bool Condition)
+{
+    printf("    %-52s %s\n", Name, Condition ? "PASS" : "FAIL");
+    return Condition ? 0 : 1;
+}
+
+/// Compares two CHAR16 strings.
+///
+/// @return true if the strings are identical
+static bool SameText(const CHAR16 *a, const CHAR16 *b)
+{
+    while (*a != 0 && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+/// Renders the most recent record in the log, which is assumed to be the only one.
+///
+/// @param Buffer receives the rendered record
+static void RenderOnlyRecord(CHAR16 *Buffer)
+{
+    uint64_t descriptor = BootLogBuffer[1];
+    const void *format = (const void *)(uintptr_t)(descriptor & BOOT_LOG_ADDRESS_MASK);
+    size_t count = (descriptor >> BOOT_LOG_COUNT_SHIFT) & 0xFF;
+    PrintRecordToBuffer(Buffer, LINE_LENGTH, format, (descriptor & BOOT_LOG_WIDE) != 0,
+                        &BootLogBuffer[BOOT_LOG_HEADER_WORDS], count);
+}
+
+// Logs a record, renders it, and compares the result with eager formatting of the same arguments.
+#define CHECK_DEFERRED(Name, Format, ...)                                                                    \
+    do {                                                                                                     \
+        CHAR16 eager[LINE_LENGTH], deferred[LINE_LENGTH];                                                    \
+        BootLogInitialize();                                                                                 \
+        BootLog(Format, ##__VA_ARGS__);                                                                      \
+        PrintToBuffer(eager, LINE_LENGTH, Format, ##__VA_ARGS__);                                            \
+        RenderOnlyRecord(deferred);                                                                          \
+        failures += Check(Name, SameText(eager, deferred));                                                  \
+    } while (0)
+
+/// Checks that deferred records render exactly as `Print` would have formatted them.
+///
+/// @return the number of failed checks
+static int TestDeferredFormatting(void)
+{
+    CHAR16 buffer[LINE_LENGTH];
+    int failures = 0;
+
+    printf("Deferred formatting:\n");
+    CHECK_DEFERRED("no arguments", "boot: stage reached\r\n");
+    CHECK_DEFERRED("signed decimal", "%d %i", -5, 2147483647);
+    CHECK_DEFERRED("unsigned and hex", "%u %x %X %o", 4000000000u, 0xBEEFu, 0xBEEFu, 8u);
+    CHECK_DEFERRED("byte and halfword modifiers", "%bd %hx %hu", -1, 0x12345, 70000);
+    CHECK_DEFERRED("64-bit modifiers", "%ld %lx", -9000000000000000LL, 0xDEADBEEFCAFEBABEULL);
+    CHECK_DEFERRED("width, zero padding and precision", "[%8d] [%08x] [%.5u]", -42, 0xABCu, 7u);
+    CHECK_DEFERRED("floating point", "%f %.2f %e %E", 3.14159, -2.5, 12345.678, 0.00042);
+    CHECK_DEFERRED("float promoted to double", "%.3f", 1.25f);
+    CHECK_DEFERRED("narrow string in narrow format", "[%s] [%.3s] [%8s]", "narrow", "truncate", "pad");
+    CHECK_DEFERRED("wide string in narrow format", "%ls", u"wide");
+    CHECK_DEFERRED("wide format", u"%s %hs %d%%", u"wide", "narrow", 100);
+    CHECK_DEFERRED("NULL string", "%s", (const char *)NULL);
+    CHECK_DEFERRED("eight arguments", "%d%d%d%d%d%d%d%d", 1, 2, 3, 4, 5, 6, 7, 8);
+
+    // A 128-bit argument is passed to BootLog as its two halves.
+    unsigned __int128 big = ((unsigned __int128)0x0123456789ABCDEFULL << 64) | 0xFEDCBA9876543210ULL;
+    CHAR16 eager[LINE_LENGTH];
+    BootLogInitialize();
+    BootLog("%qx", (uint64_t)big, (uint64_t)(big >> 64));
+    PrintToBuffer(eager, LINE_LENGTH, "%qx", big);
+    RenderOnlyRecord(buffer);
+    failures += Check("128-bit argument as two words", SameText(eager, buffer));
+
+    return failures;
+}
+
+/// Checks the record layout and the behaviour of a full log.
+///
+/// @return the number of failed checks
+static int TestRecords(void)
+{
+    int failures = 0;
+
+    printf("Records:\n");
+    BootLogInitialize();
+    BootLog("%d %d %d", 1, 2, 3);
+    failures += Check("record occupies header plus one word per argument",
+                      BootLogHead == BOOT_LOG_HEADER_WORDS + 3);
+    failures += Check("descriptor holds the argument count",
+                      ((BootLogBuffer[1] >> BOOT_LOG_COUNT_SHIFT) & 0xFF) == 3);
+    BootLog(u"wide");
+    failures += Check("wide format is flagged", (BootLogBuffer[6] & BOOT_LOG_WIDE) != 0);
+    failures += Check("narrow format is not flagged", (BootLogBuffer[1] & BOOT_LOG_WIDE) == 0);
+    failures += Check("timestamps do not decrease", BootLogBuffer[5] >= BootLogBuffer[0]);
+
+    BootLogInitialize();
+    while (BootLogDropped == 0)
+        BootLog("filler %d\r\n", 0);
+    size_t head = BootLogHead;
+    BootLog("one more %d\r\n", 0);
+    failures += Check("full log drops records", BootLogDropped == 2 && BootLogHead == head);
+    failures += Check("full log stays within its buffer", BootLogHead <= BOOT_LOG_WORDS);
+
+    return failures;
+}
+
+struct Lines {
+    CHAR16 Text[8][LINE_LENGTH];
+    size_t Count;
+};
+
+/// Collects rendered lines, without their timestamp prefix.
+static void CollectLine(const CHAR16 *Line, void *Context)
+{
+    struct Lines *lines = Context;
+    const CHAR16 *text = Line;
+    if (*text == '[') {
+        while (*text != 0 && *text != ']')
+            text++;
+        text += (*text == ']') ? 2 : 0;
+    }
+    if (lines->Count < 8) {
+        size_t i = 0;
+        for (; text[i] != 0 && i + 1 < LINE_LENGTH; i++)
+            lines->Text[lines->Count][i] = text[i];
+        lines->Text[lines->Count][i] = 0;
+    }
+    lines->Count++;
+}
+
+/// Checks that an exported image carries its own strings and renders without the originals.
+///
+/// @return the number of failed checks
+static int TestExport(void)
+{
+    char device[] = "disk0";
+    struct Lines lines = { .Count = 0 };
+    struct BootLogImage *header;
+    VOID *image;
+    UINTN size;
+    int failures = 0;
+
+    printf("Export:\n");
+    BootLogInitialize();
+    for (int i = 0; i < 2; i++)
+        BootLog("loader: probing %s, attempt %d\r\n", device, i);
+    BootLog(u"loader: %s found\r\n", u"kernel.elf");
+    BootLog("value %lx\r\n", 0xFEEDULL);
+
+    failures += Check("export succeeds", BootLogExport(&image, &size) == EFI_SUCCESS);
+    header = image;
+    failures += Check("repeated strings are stored once",
+                      header->StringBytes == sizeof("loader: probing %s, attempt %d\r\n") + sizeof("disk0") +
+                                             sizeof(u"loader: %s found\r\n") + sizeof(u"kernel.elf") +
+                                             sizeof("value %lx\r\n") + 1);
+
+    // The image must not depend on the memory the strings came from.
+    strcpy(device, "XXXXX");
+    failures += Check("image renders", BootLogRender(image, size, CollectLine, &lines) == EFI_SUCCESS);
+    failures += Check("one line per record", lines.Count == 4);
+    failures += Check("string arguments are captured at export",
+                      SameText(lines.Text[1], u"loader: probing disk0, attempt 1\r\n"));
+    failures += Check("wide format and wide argument",
+                      SameText(lines.Text[2], u"loader: kernel.elf found\r\n"));
+    failures += Check("value arguments are preserved", SameText(lines.Text[3], u"value feed\r\n"));
+
+    lines.Count = 0;
+    failures += Check("truncated image is rejected",
+                      BootLogRender(image, size - 1, CollectLine, &lines) == EFI_VOLUME_CORRUPTED);
+    header->RecordWords++;
+    failures += Check("inconsistent record count is rejected",
+                      BootLogRender(image, size, CollectLine, &lines) == EFI_VOLUME_CORRUPTED);
+    header->RecordWords--;
+    header->Signature = 0;
+    failures += Check("bad signature is rejected",
+                      BootLogRender(image, size, CollectLine, &lines) == EFI_VOLUME_CORRUPTED);
+
+    UefiFreePool(image);
+    return failures;
+}
+
+int main()
+{
+    EFI_SYSTEM_TABLE systemTable = { 0 };
+    EFI_BOOT_SERVICES bootServices;
+    int failures = 0;
+
+    // Only pool allocation is needed, for BootLogExport.
+    InitializeBootServices(&bootServices, 64 << 20);
+    systemTable.BootServices = &bootServices;
+    UefiInitializeLib(NULL, &systemTable);
+    BeginImage();
+
+    failures += TestDeferredFormatting();
+    failures += TestRecords();
+    failures += TestExport();
+
+    printf("%d failure(s)\n", failures);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
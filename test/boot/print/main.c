@@ -2,12 +2,13 @@
 // Title       : Main File, UEFI Print Utility Tests, UEFI Bootloader Test Suite                            //
 // Filename    : main.c                                                                                     //
 // Description : Provides the main program file for the test of the formatted-print (Print) functionality   //
-//               incorporated into Shasta's UEFI bootloader.                                                //
+//               incorporated into Shasta's UEFI bootloader. Builds against the bootloader's uefiutil.c,    //
+//               with the pool allocator and console from the UEFI simulator in ../sim.                     //
 //                                                                                                          //
 // Project     : Shasta Microkernel                                                                         //
 // Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
 // Created     : August 30, 2023                                                                            //
-// Modified    : August 31, 2023                                                                            //
+// Modified    : October 19, 2026                                                                           //
 // Version     : 0.0.0                                                                                      //
 // License     : GNU General Public License (GPL) version 3.0                                               //
 // Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
@@ -29,33 +30,134 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "uefi_harness.h"
-#include "uefi_print.h"
+#include "uefi_sim.h"
+#include "uefiutil.h"
 
-int main()
+bool SimQuiet;
+
+static EFI_STATUS (EFIAPI *ConsoleOutputString)(SIMPLE_TEXT_OUTPUT_INTERFACE *, CHAR16 *);
+
+/// Compares a formatted CHAR16 buffer against the expected output and reports the result.
+///
+/// @param Name     a short description of the case under test
+/// @param Actual   the buffer produced by the formatter
+/// @param Expected the expected output
+/// @return         true if the strings match, false otherwise
+static bool CheckFormatted(const char *Name, const CHAR16 *Actual, const CHAR16 *Expected)
 {
-    const char *String = "Some basic format specifiers: %u, %3d, %.2f, %lu, %10.3lf";
+    size_t i = 0;
+    while (Actual[i] != 0 && Actual[i] == Expected[i])
+        i++;
+    bool match = (Actual[i] == Expected[i]);
+
+    printf("    %-40s %s\n", Name, match ? "PASS" : "FAIL");
+    if (!match) {
+        printf("        Mismatch at index %zu: got 0x%04X, expected 0x%04X\n", i, Actual[i], Expected[i]);
+    }
+    return match;
+}
+
+/// A console `OutputString` which fails the first time it is called and discards its output afterwards.
+///
+/// @param  This   the console protocol
+/// @param  String the chunk of output being written
+/// @return `EFI_DEVICE_ERROR` on the first call, `EFI_SUCCESS` otherwise
+static EFI_STATUS EFIAPI FailFirstOutput(SIMPLE_TEXT_OUTPUT_INTERFACE *This, CHAR16 *String)
+{
+    static int calls = 0;
+    (void)This;
+    (void)String;
+    return (calls++ == 0) ? EFI_DEVICE_ERROR : EFI_SUCCESS;
+}
+
+/// Exercises the CHAR16 formatter with both narrow and wide format strings.
+///
+/// @param  ConOut the console to which `Print` writes
+/// @return the number of failed cases
+static int TestFormatting(SIMPLE_TEXT_OUTPUT_INTERFACE *ConOut)
+{
+    CHAR16 buffer[128];
+    int failures = 0;
+
+    printf("Formatting:\n");
+
+    PrintToBuffer(buffer, 128, "Hello, world!\r\n");
+    failures += !CheckFormatted("narrow literal", buffer, u"Hello, world!\r\n");
+    PrintToBuffer(buffer, 128, u"Hello, world!\r\n");
+    failures += !CheckFormatted("wide literal", buffer, u"Hello, world!\r\n");
 
-    size_t occurrences = CountCharOccurrences(String, '%');
-    struct FormatSpecifier *fs = malloc(2 * occurrences * sizeof(struct FormatSpecifier));
-    if (fs == NULL) {
-        return EXIT_FAILURE;
+    PrintToBuffer(buffer, 128, "A run long enough to take the SSE2 widening path.");
+    failures += !CheckFormatted("narrow long run", buffer,
+                                u"A run long enough to take the SSE2 widening path.");
+
+    PrintToBuffer(buffer, 128, "%u, %3d, %-d, %x, %X, %o, %%", 42u, -7, 0, 0xBEEFu, 0xBEEFu, 8u);
+    failures += !CheckFormatted("narrow integers", buffer, u"42,  -7, 0, beef, BEEF, 10, %");
+    PrintToBuffer(buffer, 128, u"%u, %3d, %-d, %x, %X, %o, %%", 42u, -7, 0, 0xBEEFu, 0xBEEFu, 8u);
+    failures += !CheckFormatted("wide integers", buffer, u"42,  -7, 0, beef, BEEF, 10, %");
+
+    PrintToBuffer(buffer, 128, "%016lx %bd %hu %ld", 0xFFFFFFFF00ull, -1, 65535u, INT64_MIN);
+    failures += !CheckFormatted("narrow modifiers", buffer,
+                                u"000000ffffffff00 -1 65535 -9223372036854775808");
+    PrintToBuffer(buffer, 128, u"%qu", (unsigned __int128)UINT64_MAX * 10 + 9);
+    failures += !CheckFormatted("wide 128-bit", buffer, u"184467440737095516159");
+
+    PrintToBuffer(buffer, 128, "%.2f|%8.3lf|%e|%.0f", 3.14159, -2.5, 12345.678, 0.5);
+    failures += !CheckFormatted("narrow floats", buffer, u"3.14|  -2.500|1.234568e+04|1");
+    PrintToBuffer(buffer, 128, u"%.2f|%8.3lf|%E", 3.14159, -2.5, 0.00125);
+    failures += !CheckFormatted("wide floats", buffer, u"3.14|  -2.500|1.250000E-03");
+
+    PrintToBuffer(buffer, 128, "[%s] [%6s] [%.3s] [%ls]", "efi", "boot", "loader", u"wide");
+    failures += !CheckFormatted("narrow strings", buffer, u"[efi] [  boot] [loa] [wide]");
+    PrintToBuffer(buffer, 128, u"[%s] [%6s] [%.3s] [%hs]", u"efi", u"boot", u"loader", "narrow");
+    failures += !CheckFormatted("wide strings", buffer, u"[efi] [  boot] [loa] [narrow]");
+
+    size_t required = PrintToBuffer(buffer, 8, "truncated %d", 12345);
+    failures += !CheckFormatted("narrow truncation", buffer, u"truncat");
+    if (required != 15) {
+        printf("        Expected required length 15, got %zu\n", required);
+        failures++;
     }
 
-    size_t count = ParseFormattedString(String, fs, 2 * occurrences);
-    printf("Counted %d format specifier(s) in provided string.\n", count);
-    printf("Enumerating:\n");
-    for (int i = 0; i < count; i++) {
-        printf("    Specifier #%d:\n", i);
-        printf("        Location  = %d\n", fs[i].location);
-        printf("        Format    = %c\n", fs[i].format);
-        printf("        Modifier  = %c\n", fs[i].modifier);
-        printf("        Width     = %d\n", fs[i].width);
-        printf("        Precision = %d\n", fs[i].precision);
+    CHAR16 untouched[2] = { 'x', 0 };
+    required = PrintToBuffer(untouched, 0, "hello world");
+    failures += !CheckFormatted("zero-length buffer", untouched, u"x");
+    if (required != 11) {
+        printf("        Expected required length 11, got %zu\n", required);
+        failures++;
+    }
+    required = PrintToBuffer((CHAR16 *)NULL, 0, u"%d", 12345);
+    if (required != 5) {
+        printf("        Expected required length 5 for NULL buffer, got %zu\n", required);
+        failures++;
     }
 
-    size_t bytes = GetSpecifierLength(fs, count);
-    printf("These specifiers consume %d bytes of the string.\n", bytes);
+    failures += EFI_ERROR(Print("Narrow Print: %d%%\r\n", 100));
+    failures += EFI_ERROR(Print(u"Wide Print: %s\r\n", u"ok"));
+
+    // An error from an intermediate flush must survive later, successful ones. Print's buffer holds 256
+    // characters, so a 300-character field is written to the console in two parts.
+    ConOut->OutputString = FailFirstOutput;
+    EFI_STATUS status = Print("%300s", "");
+    ConOut->OutputString = ConsoleOutputString;
+    printf("    %-40s %s\n", "intermediate flush error", (status == EFI_DEVICE_ERROR) ? "PASS" : "FAIL");
+    failures += (status != EFI_DEVICE_ERROR);
+
+    return failures;
+}
+
+int main()
+{
+    EFI_SYSTEM_TABLE systemTable = { 0 };
+    EFI_BOOT_SERVICES bootServices;
+
+    InitializeBootServices(&bootServices, 64 << 20);
+    systemTable.BootServices = &bootServices;
+    InitializeConsole(&systemTable, NULL);
+    UefiInitializeLib(NULL, &systemTable);
+    BeginImage();
+    ConsoleOutputString = systemTable.ConOut->OutputString;
 
-    return EXIT_SUCCESS;
+    int failures = TestFormatting(systemTable.ConOut);
+    printf("%d failure(s)\n", failures);
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
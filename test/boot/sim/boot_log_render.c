@@ -0,0 +1,132 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Boot Log Renderer, UEFI Simulator, UEFI Bootloader Test Suite                              //
+// Filename    : boot_log_render.c                                                                          //
+// Description : Renders boot logs exported by the bootloader on the host, using the bootloader's own       //
+//               formatter so that the output matches what the console would have shown. Used by bootlogdump//
+//               and the boot log tests; it is not part of the bootloader image.                            //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include "boot_log_render.h"
+#include "uefiutil.h"
+
+/// Returns whether a string of the given width starts at `Offset` in the string table and is terminated
+/// within it.
+static bool ValidString(const UINT8 *Strings, UINT32 Bytes, UINT64 Offset, bool IsWide)
+{
+    if (Offset >= Bytes || (IsWide && (Offset & 1)))
+        return false;
+    if (IsWide) {
+        for (UINT64 i = Offset; i + 1 < Bytes; i += 2) {
+            if (Strings[i] == 0 && Strings[i + 1] == 0)
+                return true;
+        }
+        return false;
+    }
+    for (UINT64 i = Offset; i < Bytes; i++) {
+        if (Strings[i] == 0)
+            return true;
+    }
+    return false;
+}
+
+/// Renders an exported log image one line per record, each prefixed with its time since the log was
+/// initialized (in seconds if the image was calibrated, in ticks otherwise). The image is validated as it is
+/// rendered, so that it can safely be read from an untrusted file.
+///
+/// @param Image   the exported image
+/// @param Size    the size of the image in bytes
+/// @param Line    called with each rendered record
+/// @param Context passed through to `Line`
+/// @return        `EFI_VOLUME_CORRUPTED` if the image is malformed, `EFI_SUCCESS` otherwise
+EFI_STATUS BootLogRender(const VOID *Image, UINTN Size, BOOT_LOG_LINE Line, VOID *Context)
+{
+    const struct BootLogImage *header = Image;
+    CHAR16 text[BOOT_LOG_LINE_LENGTH];
+    char kinds[BOOT_LOG_MAX_ARGS];
+    UINT64 args[BOOT_LOG_MAX_ARGS];
+
+    if (Size < sizeof(struct BootLogImage) || header->Signature != BOOT_LOG_SIGNATURE ||
+        header->Version != BOOT_LOG_VERSION || header->HeaderSize < sizeof(struct BootLogImage) ||
+        Size < header->HeaderSize + (UINT64)header->RecordWords * sizeof(UINT64) + header->StringBytes)
+        return EFI_VOLUME_CORRUPTED;
+
+    const UINT64 *records = (const UINT64 *)((const UINT8 *)Image + header->HeaderSize);
+    const UINT8 *strings = (const UINT8 *)(records + header->RecordWords);
+
+    for (UINTN index = 0; index < header->RecordWords;) {
+        if (index + BOOT_LOG_HEADER_WORDS > header->RecordWords)
+            return EFI_VOLUME_CORRUPTED;
+
+        UINT64 descriptor = records[index + 1];
+        UINTN count = BootLogRecordCount(descriptor);
+        bool isWide = (descriptor & BOOT_LOG_WIDE) != 0;
+        UINT64 offset = descriptor & BOOT_LOG_ADDRESS_MASK;
+        if (count > BOOT_LOG_MAX_ARGS || index + BOOT_LOG_HEADER_WORDS + count > header->RecordWords)
+            return EFI_VOLUME_CORRUPTED;
+
+        // A format string which did not fit in the string table at export time is reported as such.
+        const VOID *format = strings + offset;
+        if (offset == (BOOT_LOG_NO_STRING & BOOT_LOG_ADDRESS_MASK)) {
+            format = "(format string unavailable)\r\n";
+            isWide = false;
+        }
+        else if (!ValidString(strings, header->StringBytes, offset, isWide)) {
+            return EFI_VOLUME_CORRUPTED;
+        }
+        size_t used = ClassifyArguments(format, isWide, kinds, BOOT_LOG_MAX_ARGS);
+        for (UINTN i = 0; i < count; i++) {
+            args[i] = records[index + BOOT_LOG_HEADER_WORDS + i];
+            if (i < used && (kinds[i] == 's' || kinds[i] == 'S')) {
+                bool argIsWide = (kinds[i] == 'S');
+                if (args[i] == BOOT_LOG_NO_STRING ||
+                    !ValidString(strings, header->StringBytes, args[i], argIsWide))
+                    args[i] = 0;
+                else
+                    args[i] = (UINT64)(UINTN)(strings + args[i]);
+            }
+        }
+
+        UINT64 ticks = records[index] - header->BaseTimestamp;
+        size_t length;
+        if (header->TicksPerSecond != 0) {
+            UINT64 micros = (UINT64)((unsigned __int128)ticks * 1000000 / header->TicksPerSecond);
+            length = PrintToBufferNarrow(text, BOOT_LOG_LINE_LENGTH, "[%5lu.%06lu] ", micros / 1000000,
+                                         micros % 1000000);
+        }
+        else {
+            length = PrintToBufferNarrow(text, BOOT_LOG_LINE_LENGTH, "[%12lu] ", ticks);
+        }
+        PrintRecordToBuffer(text + length, BOOT_LOG_LINE_LENGTH - length, format, isWide, args, count);
+        Line(text, Context);
+
+        index += BOOT_LOG_HEADER_WORDS + count;
+    }
+
+    if (header->Dropped != 0) {
+        PrintToBufferNarrow(text, BOOT_LOG_LINE_LENGTH, "[bootlog] %u record(s) dropped\r\n",
+                            header->Dropped);
+        Line(text, Context);
+    }
+    return EFI_SUCCESS;
+}
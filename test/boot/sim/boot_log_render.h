@@ -1,12 +1,13 @@
 // -------------------------------------------------------------------------------------------------------- //
-// Title       : UEFI Print Functions (Header), UEFI Print Utility Tests, UEFI Bootloader Test Suite        //
-// Filename    : main.c                                                                                     //
-// Description : Provides the header file for the Print function and some necessary auxiliary functions.    //
+// Title       : Boot Log Renderer (Header), UEFI Simulator, UEFI Bootloader Test Suite                     //
+// Filename    : boot_log_render.h                                                                          //
+// Description : Declares the host-side renderer for boot logs exported by the bootloader. Rendering is only//
+//               ever done on the host, so it is kept out of the bootloader image.                          //
 //                                                                                                          //
 // Project     : Shasta Microkernel                                                                         //
 // Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
-// Created     : August 30, 2023                                                                            //
-// Modified    : August 31, 2023                                                                            //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
 // Version     : 0.0.0                                                                                      //
 // License     : GNU General Public License (GPL) version 3.0                                               //
 // Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
@@ -25,25 +26,15 @@
 //     <http://www.gnu.org/licenses/>.                                                                      //
 // -------------------------------------------------------------------------------------------------------- //
 
-#ifndef UEFI_PRINT_H_INCLUDED
-#define UEFI_PRINT_H_INCLUDED
+#ifndef BOOT_LOG_RENDER_H_INCLUDED
+#define BOOT_LOG_RENDER_H_INCLUDED
 
-#include "uefi_harness.h"
+#include "bootlog.h"
 
-struct FormatSpecifier {
-    int  location;
-    char format;
-    char modifier;
-    int  width;
-    int  precision;
-    bool hasPrecision;
-};
+#define BOOT_LOG_LINE_LENGTH    512
 
-size_t     StringLength        (const char *String);
-size_t     CountCharOccurrences(const char *String, const char c);
-size_t     ParseFormattedString(const char *Format, struct FormatSpecifier *fs, size_t NumAlloc);
-size_t     GetSpecifierLength  (struct FormatSpecifier *fs, size_t SpecifierCount);
-size_t     TotalFormattedLength(const char *Format, struct FormatSpecifier *fs, size_t SpecifierCount);
-EFI_STATUS Print               (const char *Format, ...);
+typedef void (*BOOT_LOG_LINE)(const CHAR16 *Line, VOID *Context);
 
-#endif // UEFI_PRINT_H_INCLUDED
+EFI_STATUS  BootLogRender   (const VOID *Image, UINTN Size, BOOT_LOG_LINE Line, VOID *Context);
+
+#endif // BOOT_LOG_RENDER_H_INCLUDED
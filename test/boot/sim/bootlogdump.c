@@ -0,0 +1,91 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Boot Log Decoder, UEFI Simulator, UEFI Bootloader Test Suite                               //
+// Filename    : bootlogdump.c                                                                              //
+// Description : Renders a boot log exported by the bootloader (bootlog.bin) on the host, using the         //
+//               bootloader's own formatter so that the output matches what the console would have shown.   //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "uefi_sim.h"
+#include "boot_log_render.h"
+
+/// Writes one rendered record to stdout as UTF-8, dropping carriage returns.
+///
+/// @param Line    the rendered record
+/// @param Context the output stream
+static void WriteLine(const CHAR16 *Line, VOID *Context)
+{
+    FILE *out = Context;
+    for (; *Line != 0; Line++) {
+        CHAR16 c = *Line;
+        if (c == '\r')
+            continue;
+        if (c < 0x80) {
+            fputc(c, out);
+        }
+        else if (c < 0x800) {
+            fputc(0xC0 | (c >> 6), out);
+            fputc(0x80 | (c & 0x3F), out);
+        }
+        else {
+            fputc(0xE0 | (c >> 12), out);
+            fputc(0x80 | ((c >> 6) & 0x3F), out);
+            fputc(0x80 | (c & 0x3F), out);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s BOOTLOG\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *file = fopen(argv[1], "rb");
+    if (file == NULL) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+
+    VOID *image = malloc(size > 0 ? (size_t)size : 1);
+    if (size < 0 || fread(image, 1, (size_t)size, file) != (size_t)size) {
+        fprintf(stderr, "%s: read error\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    fclose(file);
+
+    EFI_STATUS status = BootLogRender(image, (UINTN)size, WriteLine, stdout);
+    free(image);
+    if (EFI_ERROR(status)) {
+        fprintf(stderr, "%s: not a valid boot log\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,598 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Host UEFI Definitions (Header), UEFI Simulator, UEFI Bootloader Test Suite                 //
+// Filename    : efi.h                                                                                      //
+// Description : Stands in for the GNU-EFI <efi.h> when the bootloader sources are built as a host program. //
+//               Declares the subset of UEFI types, status codes, protocols and service tables used by      //
+//               /src/boot, laid out in the order given by the UEFI specification.                          //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#ifndef EFI_H_INCLUDED
+#define EFI_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---- Base types and calling convention ----------------------------------------------------------------- //
+
+// The simulator links the bootloader directly against host code, so the native calling convention is used.
+#define EFIAPI
+#define IN
+#define OUT
+#define OPTIONAL
+#define CONST           const
+#define VOID            void
+
+#define TRUE            ((BOOLEAN)1)
+#define FALSE           ((BOOLEAN)0)
+
+typedef uint8_t         UINT8;
+typedef uint16_t        UINT16;
+typedef uint32_t        UINT32;
+typedef uint64_t        UINT64;
+typedef int8_t          INT8;
+typedef int16_t         INT16;
+typedef int32_t         INT32;
+typedef int64_t         INT64;
+typedef uint64_t        UINTN;
+typedef int64_t         INTN;
+typedef uint8_t         BOOLEAN;
+typedef uint8_t         CHAR8;
+typedef uint16_t        CHAR16;
+
+typedef UINTN           EFI_STATUS;
+typedef UINTN           EFI_TPL;
+typedef UINT64          EFI_LBA;
+typedef UINT64          EFI_PHYSICAL_ADDRESS;
+typedef UINT64          EFI_VIRTUAL_ADDRESS;
+typedef VOID           *EFI_HANDLE;
+typedef VOID           *EFI_EVENT;
+
+typedef struct {
+    UINT32 Data1;
+    UINT16 Data2;
+    UINT16 Data3;
+    UINT8  Data4[8];
+} EFI_GUID;
+
+typedef struct {
+    UINT16 Year;
+    UINT8  Month;
+    UINT8  Day;
+    UINT8  Hour;
+    UINT8  Minute;
+    UINT8  Second;
+    UINT8  Pad1;
+    UINT32 Nanosecond;
+    INT16  TimeZone;
+    UINT8  Daylight;
+    UINT8  Pad2;
+} EFI_TIME;
+
+typedef struct {
+    UINT32 Resolution;
+    UINT32 Accuracy;
+    BOOLEAN SetsToZero;
+} EFI_TIME_CAPABILITIES;
+
+typedef struct {
+    UINT64 Signature;
+    UINT32 Revision;
+    UINT32 HeaderSize;
+    UINT32 CRC32;
+    UINT32 Reserved;
+} EFI_TABLE_HEADER;
+
+// ---- Status codes -------------------------------------------------------------------------------------- //
+
+#define EFI_ERROR_MASK              0x8000000000000000ULL
+#define EFIERR(a)                   (EFI_ERROR_MASK | (a))
+#define EFI_ERROR(a)                (((INTN)(a)) < 0)
+
+#define EFI_SUCCESS                 0
+#define EFI_LOAD_ERROR              EFIERR(1)
+#define EFI_INVALID_PARAMETER       EFIERR(2)
+#define EFI_UNSUPPORTED             EFIERR(3)
+#define EFI_BAD_BUFFER_SIZE         EFIERR(4)
+#define EFI_BUFFER_TOO_SMALL        EFIERR(5)
+#define EFI_NOT_READY               EFIERR(6)
+#define EFI_DEVICE_ERROR            EFIERR(7)
+#define EFI_WRITE_PROTECTED         EFIERR(8)
+#define EFI_OUT_OF_RESOURCES        EFIERR(9)
+#define EFI_VOLUME_CORRUPTED        EFIERR(10)
+#define EFI_VOLUME_FULL             EFIERR(11)
+#define EFI_NO_MEDIA                EFIERR(12)
+#define EFI_MEDIA_CHANGED           EFIERR(13)
+#define EFI_NOT_FOUND               EFIERR(14)
+#define EFI_ACCESS_DENIED           EFIERR(15)
+#define EFI_NO_RESPONSE             EFIERR(16)
+#define EFI_NO_MAPPING              EFIERR(17)
+#define EFI_TIMEOUT                 EFIERR(18)
+#define EFI_NOT_STARTED             EFIERR(19)
+#define EFI_ALREADY_STARTED         EFIERR(20)
+#define EFI_ABORTED                 EFIERR(21)
+#define EFI_ICMP_ERROR              EFIERR(22)
+#define EFI_TFTP_ERROR              EFIERR(23)
+#define EFI_PROTOCOL_ERROR          EFIERR(24)
+#define EFI_INCOMPATIBLE_VERSION    EFIERR(25)
+#define EFI_SECURITY_VIOLATION      EFIERR(26)
+#define EFI_CRC_ERROR               EFIERR(27)
+#define EFI_END_OF_MEDIA            EFIERR(28)
+#define EFI_END_OF_FILE             EFIERR(31)
+
+#define EFI_WARN_DELETE_FAILURE     2
+
+// ---- Memory -------------------------------------------------------------------------------------------- //
+
+#define EFI_PAGE_SIZE               4096
+#define EFI_PAGE_SHIFT              12
+#define EFI_SIZE_TO_PAGES(a)        (((a) >> EFI_PAGE_SHIFT) + (((a) & (EFI_PAGE_SIZE - 1)) ? 1 : 0))
+
+#define EFI_MEMORY_WB               0x0000000000000008ULL
+
+typedef enum {
+    EfiReservedMemoryType,
+    EfiLoaderCode,
+    EfiLoaderData,
+    EfiBootServicesCode,
+    EfiBootServicesData,
+    EfiRuntimeServicesCode,
+    EfiRuntimeServicesData,
+    EfiConventionalMemory,
+    EfiUnusableMemory,
+    EfiACPIReclaimMemory,
+    EfiACPIMemoryNVS,
+    EfiMemoryMappedIO,
+    EfiMemoryMappedIOPortSpace,
+    EfiPalCode,
+    EfiPersistentMemory,
+    EfiMaxMemoryType
+} EFI_MEMORY_TYPE;
+
+typedef enum {
+    AllocateAnyPages,
+    AllocateMaxAddress,
+    AllocateAddress,
+    MaxAllocateType
+} EFI_ALLOCATE_TYPE;
+
+typedef struct {
+    UINT32               Type;
+    EFI_PHYSICAL_ADDRESS PhysicalStart;
+    EFI_VIRTUAL_ADDRESS  VirtualStart;
+    UINT64               NumberOfPages;
+    UINT64               Attribute;
+} EFI_MEMORY_DESCRIPTOR;
+
+// ---- Events -------------------------------------------------------------------------------------------- //
+
+#define EVT_TIMER                   0x80000000
+#define EVT_RUNTIME                 0x40000000
+#define EVT_NOTIFY_WAIT             0x00000100
+#define EVT_NOTIFY_SIGNAL           0x00000200
+
+#define TPL_APPLICATION             4
+#define TPL_CALLBACK                8
+#define TPL_NOTIFY                  16
+#define TPL_HIGH_LEVEL              31
+
+typedef enum {
+    TimerCancel,
+    TimerPeriodic,
+    TimerRelative
+} EFI_TIMER_DELAY;
+
+typedef VOID (EFIAPI *EFI_EVENT_NOTIFY)(EFI_EVENT Event, VOID *Context);
+
+// ---- Handles and device paths -------------------------------------------------------------------------- //
+
+typedef enum {
+    AllHandles,
+    ByRegisterNotify,
+    ByProtocol
+} EFI_LOCATE_SEARCH_TYPE;
+
+typedef enum {
+    EFI_NATIVE_INTERFACE
+} EFI_INTERFACE_TYPE;
+
+#define EFI_OPEN_PROTOCOL_BY_HANDLE_PROTOCOL    0x00000001
+#define EFI_OPEN_PROTOCOL_GET_PROTOCOL          0x00000002
+
+typedef struct _EFI_DEVICE_PATH_PROTOCOL {
+    UINT8 Type;
+    UINT8 SubType;
+    UINT8 Length[2];
+} EFI_DEVICE_PATH_PROTOCOL;
+
+typedef EFI_DEVICE_PATH_PROTOCOL EFI_DEVICE_PATH;
+
+#define HARDWARE_DEVICE_PATH            0x01
+#define HW_VENDOR_DP                    0x04
+#define MEDIA_DEVICE_PATH               0x04
+#define MEDIA_FILEPATH_DP               0x04
+#define END_DEVICE_PATH_TYPE            0x7F
+#define END_ENTIRE_DEVICE_PATH_SUBTYPE  0xFF
+#define END_DEVICE_PATH_LENGTH          (sizeof(EFI_DEVICE_PATH))
+
+#define EFI_DP_TYPE_MASK                0x7F
+
+#define DevicePathType(a)               (((a)->Type) & EFI_DP_TYPE_MASK)
+#define DevicePathSubType(a)            ((a)->SubType)
+#define DevicePathNodeLength(a)         ((UINTN)(((a)->Length[0]) | ((a)->Length[1] << 8)))
+#define NextDevicePathNode(a)           ((EFI_DEVICE_PATH *)(((UINT8 *)(a)) + DevicePathNodeLength(a)))
+#define IsDevicePathEndType(a)          (DevicePathType(a) == END_DEVICE_PATH_TYPE)
+#define IsDevicePathEnd(a)              (IsDevicePathEndType(a) && DevicePathSubType(a) == \
+                                         END_ENTIRE_DEVICE_PATH_SUBTYPE)
+
+#define EFI_DEVICE_PATH_PROTOCOL_GUID \
+    { 0x09576e91, 0x6d3f, 0x11d2, { 0x8e, 0x39, 0x00, 0xa0, 0xc9, 0x69, 0x72, 0x3b } }
+
+// ---- Console ------------------------------------------------------------------------------------------- //
+
+typedef struct {
+    UINT16 ScanCode;
+    CHAR16 UnicodeChar;
+} EFI_INPUT_KEY;
+
+struct _SIMPLE_INPUT_INTERFACE;
+struct _SIMPLE_TEXT_OUTPUT_INTERFACE;
+
+typedef EFI_STATUS (EFIAPI *EFI_INPUT_RESET)(struct _SIMPLE_INPUT_INTERFACE *This,
+                                             BOOLEAN ExtendedVerification);
+typedef EFI_STATUS (EFIAPI *EFI_INPUT_READ_KEY)(struct _SIMPLE_INPUT_INTERFACE *This, EFI_INPUT_KEY *Key);
+
+typedef struct _SIMPLE_INPUT_INTERFACE {
+    EFI_INPUT_RESET    Reset;
+    EFI_INPUT_READ_KEY ReadKeyStroke;
+    EFI_EVENT          WaitForKey;
+} SIMPLE_INPUT_INTERFACE, EFI_SIMPLE_TEXT_INPUT_PROTOCOL;
+
+typedef struct {
+    INT32   MaxMode;
+    INT32   Mode;
+    INT32   Attribute;
+    INT32   CursorColumn;
+    INT32   CursorRow;
+    BOOLEAN CursorVisible;
+} SIMPLE_TEXT_OUTPUT_MODE;
+
+typedef EFI_STATUS (EFIAPI *EFI_TEXT_RESET)(struct _SIMPLE_TEXT_OUTPUT_INTERFACE *This,
+                                            BOOLEAN ExtendedVerification);
+typedef EFI_STATUS (EFIAPI *EFI_TEXT_OUTPUT_STRING)(struct _SIMPLE_TEXT_OUTPUT_INTERFACE *This,
+                                                    CHAR16 *String);
+typedef EFI_STATUS (EFIAPI *EFI_TEXT_TEST_STRING)(struct _SIMPLE_TEXT_OUTPUT_INTERFACE *This, CHAR16 *String);
+typedef EFI_STATUS (EFIAPI *EFI_TEXT_QUERY_MODE)(struct _SIMPLE_TEXT_OUTPUT_INTERFACE *This, UINTN ModeNumber,
+                                                 UINTN *Columns, UINTN *Rows);
+typedef EFI_STATUS (EFIAPI *EFI_TEXT_SET_MODE)(struct _SIMPLE_TEXT_OUTPUT_INTERFACE *This, UINTN ModeNumber);
+typedef EFI_STATUS (EFIAPI *EFI_TEXT_SET_ATTRIBUTE)(struct _SIMPLE_TEXT_OUTPUT_INTERFACE *This,
+                                                    UINTN Attribute);
+typedef EFI_STATUS (EFIAPI *EFI_TEXT_CLEAR_SCREEN)(struct _SIMPLE_TEXT_OUTPUT_INTERFACE *This);
+typedef EFI_STATUS (EFIAPI *EFI_TEXT_SET_CURSOR_POSITION)(struct _SIMPLE_TEXT_OUTPUT_INTERFACE *This,
+                                                          UINTN Column, UINTN Row);
+typedef EFI_STATUS (EFIAPI *EFI_TEXT_ENABLE_CURSOR)(struct _SIMPLE_TEXT_OUTPUT_INTERFACE *This,
+                                                    BOOLEAN Visible);
+
+typedef struct _SIMPLE_TEXT_OUTPUT_INTERFACE {
+    EFI_TEXT_RESET               Reset;
+    EFI_TEXT_OUTPUT_STRING       OutputString;
+    EFI_TEXT_TEST_STRING         TestString;
+    EFI_TEXT_QUERY_MODE          QueryMode;
+    EFI_TEXT_SET_MODE            SetMode;
+    EFI_TEXT_SET_ATTRIBUTE       SetAttribute;
+    EFI_TEXT_CLEAR_SCREEN        ClearScreen;
+    EFI_TEXT_SET_CURSOR_POSITION SetCursorPosition;
+    EFI_TEXT_ENABLE_CURSOR       EnableCursor;
+    SIMPLE_TEXT_OUTPUT_MODE     *Mode;
+} SIMPLE_TEXT_OUTPUT_INTERFACE, EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL;
+
+// ---- Boot services ------------------------------------------------------------------------------------- //
+
+typedef EFI_TPL    (EFIAPI *EFI_RAISE_TPL)(EFI_TPL NewTpl);
+typedef VOID       (EFIAPI *EFI_RESTORE_TPL)(EFI_TPL OldTpl);
+typedef EFI_STATUS (EFIAPI *EFI_ALLOCATE_PAGES)(EFI_ALLOCATE_TYPE Type, EFI_MEMORY_TYPE MemoryType,
+                                                UINTN Pages, EFI_PHYSICAL_ADDRESS *Memory);
+typedef EFI_STATUS (EFIAPI *EFI_FREE_PAGES)(EFI_PHYSICAL_ADDRESS Memory, UINTN Pages);
+typedef EFI_STATUS (EFIAPI *EFI_GET_MEMORY_MAP)(UINTN *MemoryMapSize, EFI_MEMORY_DESCRIPTOR *MemoryMap,
+                                                UINTN *MapKey, UINTN *DescriptorSize,
+                                                UINT32 *DescriptorVersion);
+typedef EFI_STATUS (EFIAPI *EFI_ALLOCATE_POOL)(EFI_MEMORY_TYPE PoolType, UINTN Size, VOID **Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_FREE_POOL)(VOID *Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_CREATE_EVENT)(UINT32 Type, EFI_TPL NotifyTpl, EFI_EVENT_NOTIFY NotifyFunction,
+                                              VOID *NotifyContext, EFI_EVENT *Event);
+typedef EFI_STATUS (EFIAPI *EFI_SET_TIMER)(EFI_EVENT Event, EFI_TIMER_DELAY Type, UINT64 TriggerTime);
+typedef EFI_STATUS (EFIAPI *EFI_WAIT_FOR_EVENT)(UINTN NumberOfEvents, EFI_EVENT *Event, UINTN *Index);
+typedef EFI_STATUS (EFIAPI *EFI_SIGNAL_EVENT)(EFI_EVENT Event);
+typedef EFI_STATUS (EFIAPI *EFI_CLOSE_EVENT)(EFI_EVENT Event);
+typedef EFI_STATUS (EFIAPI *EFI_CHECK_EVENT)(EFI_EVENT Event);
+typedef EFI_STATUS (EFIAPI *EFI_INSTALL_PROTOCOL_INTERFACE)(EFI_HANDLE *Handle, EFI_GUID *Protocol,
+                                                            EFI_INTERFACE_TYPE InterfaceType,
+                                                            VOID *Interface);
+typedef EFI_STATUS (EFIAPI *EFI_HANDLE_PROTOCOL)(EFI_HANDLE Handle, EFI_GUID *Protocol, VOID **Interface);
+typedef EFI_STATUS (EFIAPI *EFI_LOCATE_HANDLE)(EFI_LOCATE_SEARCH_TYPE SearchType, EFI_GUID *Protocol,
+                                               VOID *SearchKey, UINTN *BufferSize, EFI_HANDLE *Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_LOCATE_DEVICE_PATH)(EFI_GUID *Protocol, EFI_DEVICE_PATH **DevicePath,
+                                                    EFI_HANDLE *Device);
+typedef EFI_STATUS (EFIAPI *EFI_EXIT_BOOT_SERVICES)(EFI_HANDLE ImageHandle, UINTN MapKey);
+typedef EFI_STATUS (EFIAPI *EFI_GET_NEXT_MONOTONIC_COUNT)(UINT64 *Count);
+typedef EFI_STATUS (EFIAPI *EFI_STALL)(UINTN Microseconds);
+typedef EFI_STATUS (EFIAPI *EFI_SET_WATCHDOG_TIMER)(UINTN Timeout, UINT64 WatchdogCode, UINTN DataSize,
+                                                    CHAR16 *WatchdogData);
+typedef EFI_STATUS (EFIAPI *EFI_OPEN_PROTOCOL)(EFI_HANDLE Handle, EFI_GUID *Protocol, VOID **Interface,
+                                               EFI_HANDLE AgentHandle, EFI_HANDLE ControllerHandle,
+                                               UINT32 Attributes);
+typedef EFI_STATUS (EFIAPI *EFI_CLOSE_PROTOCOL)(EFI_HANDLE Handle, EFI_GUID *Protocol, EFI_HANDLE AgentHandle,
+                                                EFI_HANDLE ControllerHandle);
+typedef EFI_STATUS (EFIAPI *EFI_LOCATE_HANDLE_BUFFER)(EFI_LOCATE_SEARCH_TYPE SearchType, EFI_GUID *Protocol,
+                                                      VOID *SearchKey, UINTN *NoHandles, EFI_HANDLE **Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_LOCATE_PROTOCOL)(EFI_GUID *Protocol, VOID *Registration, VOID **Interface);
+typedef EFI_STATUS (EFIAPI *EFI_CALCULATE_CRC32)(VOID *Data, UINTN DataSize, UINT32 *Crc32);
+typedef VOID       (EFIAPI *EFI_COPY_MEM)(VOID *Destination, VOID *Source, UINTN Length);
+typedef VOID       (EFIAPI *EFI_SET_MEM)(VOID *Buffer, UINTN Size, UINT8 Value);
+
+// Services not provided by the simulator are declared as untyped slots and left NULL, so that any use of
+// them faults immediately rather than misbehaving silently.
+typedef struct {
+    EFI_TABLE_HEADER               Hdr;
+    EFI_RAISE_TPL                  RaiseTPL;
+    EFI_RESTORE_TPL                RestoreTPL;
+    EFI_ALLOCATE_PAGES             AllocatePages;
+    EFI_FREE_PAGES                 FreePages;
+    EFI_GET_MEMORY_MAP             GetMemoryMap;
+    EFI_ALLOCATE_POOL              AllocatePool;
+    EFI_FREE_POOL                  FreePool;
+    EFI_CREATE_EVENT               CreateEvent;
+    EFI_SET_TIMER                  SetTimer;
+    EFI_WAIT_FOR_EVENT             WaitForEvent;
+    EFI_SIGNAL_EVENT               SignalEvent;
+    EFI_CLOSE_EVENT                CloseEvent;
+    EFI_CHECK_EVENT                CheckEvent;
+    EFI_INSTALL_PROTOCOL_INTERFACE InstallProtocolInterface;
+    VOID                          *ReinstallProtocolInterface;
+    VOID                          *UninstallProtocolInterface;
+    EFI_HANDLE_PROTOCOL            HandleProtocol;
+    VOID                          *Reserved;
+    VOID                          *RegisterProtocolNotify;
+    EFI_LOCATE_HANDLE              LocateHandle;
+    EFI_LOCATE_DEVICE_PATH         LocateDevicePath;
+    VOID                          *InstallConfigurationTable;
+    VOID                          *LoadImage;
+    VOID                          *StartImage;
+    VOID                          *Exit;
+    VOID                          *UnloadImage;
+    EFI_EXIT_BOOT_SERVICES         ExitBootServices;
+    EFI_GET_NEXT_MONOTONIC_COUNT   GetNextMonotonicCount;
+    EFI_STALL                      Stall;
+    EFI_SET_WATCHDOG_TIMER         SetWatchdogTimer;
+    VOID                          *ConnectController;
+    VOID                          *DisconnectController;
+    EFI_OPEN_PROTOCOL              OpenProtocol;
+    EFI_CLOSE_PROTOCOL             CloseProtocol;
+    VOID                          *OpenProtocolInformation;
+    VOID                          *ProtocolsPerHandle;
+    EFI_LOCATE_HANDLE_BUFFER       LocateHandleBuffer;
+    EFI_LOCATE_PROTOCOL            LocateProtocol;
+    VOID                          *InstallMultipleProtocolInterfaces;
+    VOID                          *UninstallMultipleProtocolInterfaces;
+    EFI_CALCULATE_CRC32            CalculateCrc32;
+    EFI_COPY_MEM                   CopyMem;
+    EFI_SET_MEM                    SetMem;
+    VOID                          *CreateEventEx;
+} EFI_BOOT_SERVICES;
+
+// ---- Runtime services ---------------------------------------------------------------------------------- //
+
+#define EFI_VARIABLE_NON_VOLATILE                           0x00000001
+#define EFI_VARIABLE_BOOTSERVICE_ACCESS                     0x00000002
+#define EFI_VARIABLE_RUNTIME_ACCESS                         0x00000004
+
+typedef enum {
+    EfiResetCold,
+    EfiResetWarm,
+    EfiResetShutdown
+} EFI_RESET_TYPE;
+
+typedef EFI_STATUS (EFIAPI *EFI_GET_TIME)(EFI_TIME *Time, EFI_TIME_CAPABILITIES *Capabilities);
+typedef EFI_STATUS (EFIAPI *EFI_GET_VARIABLE)(CHAR16 *VariableName, EFI_GUID *VendorGuid, UINT32 *Attributes,
+                                              UINTN *DataSize, VOID *Data);
+typedef EFI_STATUS (EFIAPI *EFI_GET_NEXT_VARIABLE_NAME)(UINTN *VariableNameSize, CHAR16 *VariableName,
+                                                        EFI_GUID *VendorGuid);
+typedef EFI_STATUS (EFIAPI *EFI_SET_VARIABLE)(CHAR16 *VariableName, EFI_GUID *VendorGuid, UINT32 Attributes,
+                                              UINTN DataSize, VOID *Data);
+typedef VOID       (EFIAPI *EFI_RESET_SYSTEM)(EFI_RESET_TYPE ResetType, EFI_STATUS ResetStatus,
+                                              UINTN DataSize, VOID *ResetData);
+
+typedef struct {
+    EFI_TABLE_HEADER           Hdr;
+    EFI_GET_TIME               GetTime;
+    VOID                      *SetTime;
+    VOID                      *GetWakeupTime;
+    VOID                      *SetWakeupTime;
+    VOID                      *SetVirtualAddressMap;
+    VOID                      *ConvertPointer;
+    EFI_GET_VARIABLE           GetVariable;
+    EFI_GET_NEXT_VARIABLE_NAME GetNextVariableName;
+    EFI_SET_VARIABLE           SetVariable;
+    VOID                      *GetNextHighMonotonicCount;
+    EFI_RESET_SYSTEM           ResetSystem;
+    VOID                      *UpdateCapsule;
+    VOID                      *QueryCapsuleCapabilities;
+    VOID                      *QueryVariableInfo;
+} EFI_RUNTIME_SERVICES;
+
+// ---- System table -------------------------------------------------------------------------------------- //
+
+#define EFI_SYSTEM_TABLE_SIGNATURE      0x5453595320494249ULL
+#define EFI_BOOT_SERVICES_SIGNATURE     0x56524553544f4f42ULL
+#define EFI_RUNTIME_SERVICES_SIGNATURE  0x56524553544e5552ULL
+#define EFI_SPECIFICATION_VERSION       ((2 << 16) | 70)
+
+typedef struct {
+    EFI_GUID VendorGuid;
+    VOID    *VendorTable;
+} EFI_CONFIGURATION_TABLE;
+
+typedef struct {
+    EFI_TABLE_HEADER              Hdr;
+    CHAR16                       *FirmwareVendor;
+    UINT32                        FirmwareRevision;
+    EFI_HANDLE                    ConsoleInHandle;
+    SIMPLE_INPUT_INTERFACE       *ConIn;
+    EFI_HANDLE                    ConsoleOutHandle;
+    SIMPLE_TEXT_OUTPUT_INTERFACE *ConOut;
+    EFI_HANDLE                    StandardErrorHandle;
+    SIMPLE_TEXT_OUTPUT_INTERFACE *StdErr;
+    EFI_RUNTIME_SERVICES         *RuntimeServices;
+    EFI_BOOT_SERVICES            *BootServices;
+    UINTN                         NumberOfTableEntries;
+    EFI_CONFIGURATION_TABLE      *ConfigurationTable;
+} EFI_SYSTEM_TABLE;
+
+// ---- Loaded image -------------------------------------------------------------------------------------- //
+
+#define EFI_LOADED_IMAGE_PROTOCOL_GUID \
+    { 0x5b1b31a1, 0x9562, 0x11d2, { 0x8e, 0x3f, 0x00, 0xa0, 0xc9, 0x69, 0x72, 0x3b } }
+
+typedef struct {
+    UINT32            Revision;
+    EFI_HANDLE        ParentHandle;
+    EFI_SYSTEM_TABLE *SystemTable;
+    EFI_HANDLE        DeviceHandle;
+    EFI_DEVICE_PATH  *FilePath;
+    VOID             *Reserved;
+    UINT32            LoadOptionsSize;
+    VOID             *LoadOptions;
+    VOID             *ImageBase;
+    UINT64            ImageSize;
+    EFI_MEMORY_TYPE   ImageCodeType;
+    EFI_MEMORY_TYPE   ImageDataType;
+    VOID             *Unload;
+} EFI_LOADED_IMAGE, EFI_LOADED_IMAGE_PROTOCOL;
+
+// ---- File system --------------------------------------------------------------------------------------- //
+
+#define EFI_SIMPLE_FILE_SYSTEM_PROTOCOL_GUID \
+    { 0x964e5b22, 0x6459, 0x11d2, { 0x8e, 0x39, 0x00, 0xa0, 0xc9, 0x69, 0x72, 0x3b } }
+#define EFI_FILE_INFO_ID \
+    { 0x09576e92, 0x6d3f, 0x11d2, { 0x8e, 0x39, 0x00, 0xa0, 0xc9, 0x69, 0x72, 0x3b } }
+
+#define EFI_FILE_MODE_READ          0x0000000000000001ULL
+#define EFI_FILE_MODE_WRITE         0x0000000000000002ULL
+#define EFI_FILE_MODE_CREATE        0x8000000000000000ULL
+
+#define EFI_FILE_READ_ONLY          0x0000000000000001ULL
+#define EFI_FILE_HIDDEN             0x0000000000000002ULL
+#define EFI_FILE_SYSTEM             0x0000000000000004ULL
+#define EFI_FILE_RESERVED           0x0000000000000008ULL
+#define EFI_FILE_DIRECTORY          0x0000000000000010ULL
+#define EFI_FILE_ARCHIVE            0x0000000000000020ULL
+
+typedef struct {
+    UINT64   Size;
+    UINT64   FileSize;
+    UINT64   PhysicalSize;
+    EFI_TIME CreateTime;
+    EFI_TIME LastAccessTime;
+    EFI_TIME ModificationTime;
+    UINT64   Attribute;
+    CHAR16   FileName[1];
+} EFI_FILE_INFO;
+
+#define SIZE_OF_EFI_FILE_INFO       __builtin_offsetof(EFI_FILE_INFO, FileName)
+
+struct _EFI_FILE_HANDLE;
+
+typedef EFI_STATUS (EFIAPI *EFI_FILE_OPEN)(struct _EFI_FILE_HANDLE *File, struct _EFI_FILE_HANDLE **NewHandle,
+                                           CHAR16 *FileName, UINT64 OpenMode, UINT64 Attributes);
+typedef EFI_STATUS (EFIAPI *EFI_FILE_CLOSE)(struct _EFI_FILE_HANDLE *File);
+typedef EFI_STATUS (EFIAPI *EFI_FILE_DELETE)(struct _EFI_FILE_HANDLE *File);
+typedef EFI_STATUS (EFIAPI *EFI_FILE_READ)(struct _EFI_FILE_HANDLE *File, UINTN *BufferSize, VOID *Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_FILE_WRITE)(struct _EFI_FILE_HANDLE *File, UINTN *BufferSize, VOID *Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_FILE_GET_POSITION)(struct _EFI_FILE_HANDLE *File, UINT64 *Position);
+typedef EFI_STATUS (EFIAPI *EFI_FILE_SET_POSITION)(struct _EFI_FILE_HANDLE *File, UINT64 Position);
+typedef EFI_STATUS (EFIAPI *EFI_FILE_GET_INFO)(struct _EFI_FILE_HANDLE *File, EFI_GUID *InformationType,
+                                               UINTN *BufferSize, VOID *Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_FILE_SET_INFO)(struct _EFI_FILE_HANDLE *File, EFI_GUID *InformationType,
+                                               UINTN BufferSize, VOID *Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_FILE_FLUSH)(struct _EFI_FILE_HANDLE *File);
+
+typedef struct _EFI_FILE_HANDLE {
+    UINT64                Revision;
+    EFI_FILE_OPEN         Open;
+    EFI_FILE_CLOSE        Close;
+    EFI_FILE_DELETE       Delete;
+    EFI_FILE_READ         Read;
+    EFI_FILE_WRITE        Write;
+    EFI_FILE_GET_POSITION GetPosition;
+    EFI_FILE_SET_POSITION SetPosition;
+    EFI_FILE_GET_INFO     GetInfo;
+    EFI_FILE_SET_INFO     SetInfo;
+    EFI_FILE_FLUSH        Flush;
+} EFI_FILE, EFI_FILE_PROTOCOL, *EFI_FILE_HANDLE;
+
+struct _EFI_SIMPLE_FILE_SYSTEM_PROTOCOL;
+
+typedef EFI_STATUS (EFIAPI *EFI_VOLUME_OPEN)(struct _EFI_SIMPLE_FILE_SYSTEM_PROTOCOL *This,
+                                             EFI_FILE_HANDLE *Root);
+
+typedef struct _EFI_SIMPLE_FILE_SYSTEM_PROTOCOL {
+    UINT64          Revision;
+    EFI_VOLUME_OPEN OpenVolume;
+} EFI_SIMPLE_FILE_SYSTEM_PROTOCOL, EFI_FILE_IO_INTERFACE;
+
+// ---- Block I/O ----------------------------------------------------------------------------------------- //
+
+#define EFI_BLOCK_IO_PROTOCOL_GUID \
+    { 0x964e5b21, 0x6459, 0x11d2, { 0x8e, 0x39, 0x00, 0xa0, 0xc9, 0x69, 0x72, 0x3b } }
+
+typedef struct {
+    UINT32  MediaId;
+    BOOLEAN RemovableMedia;
+    BOOLEAN MediaPresent;
+    BOOLEAN LogicalPartition;
+    BOOLEAN ReadOnly;
+    BOOLEAN WriteCaching;
+    UINT32  BlockSize;
+    UINT32  IoAlign;
+    EFI_LBA LastBlock;
+} EFI_BLOCK_IO_MEDIA;
+
+struct _EFI_BLOCK_IO;
+
+typedef EFI_STATUS (EFIAPI *EFI_BLOCK_RESET)(struct _EFI_BLOCK_IO *This, BOOLEAN ExtendedVerification);
+typedef EFI_STATUS (EFIAPI *EFI_BLOCK_READ)(struct _EFI_BLOCK_IO *This, UINT32 MediaId, EFI_LBA Lba,
+                                            UINTN BufferSize, VOID *Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_BLOCK_WRITE)(struct _EFI_BLOCK_IO *This, UINT32 MediaId, EFI_LBA Lba,
+                                             UINTN BufferSize, VOID *Buffer);
+typedef EFI_STATUS (EFIAPI *EFI_BLOCK_FLUSH)(struct _EFI_BLOCK_IO *This);
+
+typedef struct _EFI_BLOCK_IO {
+    UINT64              Revision;
+    EFI_BLOCK_IO_MEDIA *Media;
+    EFI_BLOCK_RESET     Reset;
+    EFI_BLOCK_READ      ReadBlocks;
+    EFI_BLOCK_WRITE     WriteBlocks;
+    EFI_BLOCK_FLUSH     FlushBlocks;
+} EFI_BLOCK_IO, EFI_BLOCK_IO_PROTOCOL;
+
+#endif // EFI_H_INCLUDED
@@ -1,14 +1,16 @@
 // -------------------------------------------------------------------------------------------------------- //
-// Title       : UEFI Test Harnesses (Implementation), UEFI Print Utility Tests, UEFI Bootloader Test Suite //
-// Filename    : main.c                                                                                     //
-// Description : Provides the source file for some UEFI test functionality harnesses. Mimics several UEFI   //
-//               functions incorporated into /src/boot/uefiutil.h using C standard functions to provide 1:1 //
-//               testing of the Print logic.                                                                //
+// Title       : Host UEFI Library (Header), UEFI Simulator, UEFI Bootloader Test Suite                     //
+// Filename    : efilib.h                                                                                   //
+// Description : Stands in for the GNU-EFI <efilib.h> when the bootloader sources are built as a host       //
+//               program. The bootloader has its own replacements for these library functions in            //
+//               /src/boot/uefiutil.c, under names of their own; the GNU-EFI declarations are repeated here //
+//               so that a replacement which clashes with the real library fails to compile on the host too.//
+//               Nothing here is defined by the simulator.                                                  //
 //                                                                                                          //
 // Project     : Shasta Microkernel                                                                         //
 // Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
-// Created     : August 30, 2023                                                                            //
-// Modified    : August 31, 2023                                                                            //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
 // Version     : 0.0.0                                                                                      //
 // License     : GNU General Public License (GPL) version 3.0                                               //
 // Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
@@ -27,47 +29,30 @@
 //     <http://www.gnu.org/licenses/>.                                                                      //
 // -------------------------------------------------------------------------------------------------------- //
 
-#include "uefi_harness.h"
+#ifndef EFILIB_H_INCLUDED
+#define EFILIB_H_INCLUDED
 
-/// Provides a mimic of the `EFI_ERROR` function. Returns true if the `EFI_STATUS` code provided is an error;
-/// returns false otherwise.
-///
-/// @param Status the `EFI_STATUS` to evaluate
-/// @return       a `bool` indicating whether `Status` represented an error or not
-bool EFI_ERROR(EFI_STATUS Status)
-{
-    return (Status != EFI_SUCCESS);
-}
+#include <efi.h>
 
-/// Provides a memory allocation of desired size and assigns a pointer to it. Internally, this function
-/// translates to the C standard `malloc()`; some checking is done of the returned pointer, which means
-/// that `AllocatePool` will not initialize or modify the pointer unless the operation is successful.
-///
-/// @param EfiType    the type of memory; this function only responds to EfiLoaderData
-/// @param BufferSize the desired size of the memory allocation
-/// @param Buffer     a pointer to a pointer which will be aimed at a successful allocation
-/// @return           an `EFI_STATUS` value indicating the status of the operation
-EFI_STATUS AllocatePool(EFI_MEMORY_TYPE EfiType, uint32_t BufferSize, void **Buffer)
-{
-    if (EfiType == EfiLoaderData) {
-        void *InternalBuffer = malloc(BufferSize);
-        if (InternalBuffer == NULL)
-            return EFI_BUFFER_TOO_SMALL;
-        else {
-            *Buffer = InternalBuffer;
-            return EFI_SUCCESS;
-        }
-    }
-    else return EFI_INVALID_PARAMETER;
-}
+// A subset of the GNU-EFI library interface (lib/init.c, lib/misc.c, lib/print.c, lib/str.c), as declared by
+// the real <efilib.h>.
+extern EFI_SYSTEM_TABLE     *ST;
+extern EFI_BOOT_SERVICES    *BS;
+extern EFI_RUNTIME_SERVICES *RT;
+extern EFI_HANDLE            LibImageHandle;
 
-/// Releases a memory allocation provided earlier by `AllocatePool`. Internally, this simply redirects to
-/// the C standard library function `free()`, and always returns `EFI_SUCCESS`.
-///
-/// @param  Buffer a pointer to the memory area to release
-/// @return an `EFI_STATUS` value indicating the status of the operation
-EFI_STATUS FreePool(void *Buffer)
-{
-    free(Buffer);
-    return EFI_SUCCESS;
-}
+VOID    InitializeLib       (EFI_HANDLE ImageHandle, EFI_SYSTEM_TABLE *SystemTable);
+VOID   *AllocatePool        (UINTN Size);
+VOID   *AllocateZeroPool    (UINTN Size);
+VOID   *ReallocatePool      (VOID *OldPool, UINTN OldSize, UINTN NewSize);
+VOID    FreePool            (VOID *Buffer);
+VOID    ZeroMem             (VOID *Buffer, UINTN Size);
+VOID    SetMem              (VOID *Buffer, UINTN Size, UINT8 Value);
+VOID    CopyMem             (VOID *Dest, CONST VOID *Src, UINTN Len);
+UINTN   StrLen              (CONST CHAR16 *s1);
+INTN    StrCmp              (CONST CHAR16 *s1, CONST CHAR16 *s2);
+UINTN   Print               (CONST CHAR16 *fmt, ...);
+UINTN   SPrint              (CHAR16 *Str, UINTN StrSize, CONST CHAR16 *fmt, ...);
+VOID   *LibGetVariable      (CHAR16 *Name, EFI_GUID *VendorGuid);
+
+#endif // EFILIB_H_INCLUDED
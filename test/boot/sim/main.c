@@ -0,0 +1,197 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Simulator Entry Point, UEFI Simulator, UEFI Bootloader Test Suite                          //
+// Filename    : main.c                                                                                     //
+// Description : Builds a simulated EFI system table around a host directory and runs the bootloader's      //
+//               efi_main() against it as an ordinary Linux process, optionally repeatedly to time it end to//
+//               end.                                                                                       //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "uefi_sim.h"
+
+#define DEFAULT_MEMORY_MB   256
+#define MAX_RUNS            10000
+
+EFI_STATUS efi_main(EFI_HANDLE ImageHandle, EFI_SYSTEM_TABLE *SystemTable);
+
+bool SimQuiet;
+
+static EFI_SYSTEM_TABLE     SystemTable;
+static EFI_BOOT_SERVICES    BootServices;
+static EFI_RUNTIME_SERVICES RuntimeServices;
+static EFI_LOADED_IMAGE     LoadedImage;
+static CHAR16               FirmwareVendor[] = u"Shasta UEFI Simulator";
+
+/// Builds the device path of the image file as firmware would pass it in EFI_LOADED_IMAGE.FilePath: a
+/// single file path node followed by an end node.
+///
+/// @param Path the path of the image relative to the volume root
+/// @return     a newly allocated device path
+static EFI_DEVICE_PATH *FilePathNode(const char *Path)
+{
+    UINTN length = strlen(Path);
+    UINTN nodeLength = sizeof(EFI_DEVICE_PATH) + (length + 1) * sizeof(CHAR16);
+    UINT8 *buffer = calloc(1, nodeLength + END_DEVICE_PATH_LENGTH);
+
+    EFI_DEVICE_PATH *node = (EFI_DEVICE_PATH *)buffer;
+    node->Type = MEDIA_DEVICE_PATH;
+    node->SubType = MEDIA_FILEPATH_DP;
+    node->Length[0] = (UINT8)nodeLength;
+    node->Length[1] = (UINT8)(nodeLength >> 8);
+
+    CHAR16 *name = (CHAR16 *)(buffer + sizeof(EFI_DEVICE_PATH));
+    for (UINTN i = 0; i < length; i++)
+        name[i] = (CHAR16)Path[i];
+
+    EFI_DEVICE_PATH *end = (EFI_DEVICE_PATH *)(buffer + nodeLength);
+    end->Type = END_DEVICE_PATH_TYPE;
+    end->SubType = END_ENTIRE_DEVICE_PATH_SUBTYPE;
+    end->Length[0] = END_DEVICE_PATH_LENGTH;
+    return node;
+}
+
+/// Assembles the system table and installs the image handle, as firmware does before starting an image.
+///
+/// @param Root        the host directory to expose as the boot volume
+/// @param NvramPath   the host file holding non-volatile variables, or NULL
+/// @param Keys        the scripted console input
+/// @param MemoryBytes the amount of conventional memory to report
+/// @return            the image handle, or NULL on failure
+static EFI_HANDLE InitializeFirmware(const char *Root, const char *NvramPath, const char *Keys,
+                                     UINT64 MemoryBytes)
+{
+    EFI_GUID loadedImageGuid = EFI_LOADED_IMAGE_PROTOCOL_GUID;
+    EFI_HANDLE image = NULL;
+
+    InitializeBootServices(&BootServices, MemoryBytes);
+    InitializeRuntimeServices(&RuntimeServices, NvramPath);
+
+    SystemTable.Hdr.Signature = EFI_SYSTEM_TABLE_SIGNATURE;
+    SystemTable.Hdr.Revision = EFI_SPECIFICATION_VERSION;
+    SystemTable.Hdr.HeaderSize = sizeof(EFI_SYSTEM_TABLE);
+    SystemTable.FirmwareVendor = FirmwareVendor;
+    SystemTable.FirmwareRevision = 0x00010000;
+    SystemTable.BootServices = &BootServices;
+    SystemTable.RuntimeServices = &RuntimeServices;
+    InitializeConsole(&SystemTable, Keys);
+    SystemTable.Hdr.CRC32 = CalculateTableCrc(&SystemTable.Hdr);
+
+    EFI_HANDLE volume = CreateVolume(&BootServices, Root);
+    if (volume == NULL)
+        return NULL;
+
+    LoadedImage.Revision = 0x1000;
+    LoadedImage.SystemTable = &SystemTable;
+    LoadedImage.DeviceHandle = volume;
+    LoadedImage.FilePath = FilePathNode("\\EFI\\BOOT\\BOOTX64.EFI");
+    LoadedImage.ImageCodeType = EfiLoaderCode;
+    LoadedImage.ImageDataType = EfiLoaderData;
+    if (EFI_ERROR(BootServices.InstallProtocolInterface(&image, &loadedImageGuid, EFI_NATIVE_INTERFACE,
+                                                        &LoadedImage)))
+        return NULL;
+    return image;
+}
+
+static int CompareDurations(const void *a, const void *b)
+{
+    UINT64 x = *(const UINT64 *)a, y = *(const UINT64 *)b;
+    return (x > y) - (x < y);
+}
+
+static void Usage(const char *Program)
+{
+    fprintf(stderr,
+            "usage: %s [-q] [-d DIR] [-n NVRAM] [-k KEYS] [-m MB] [-r RUNS]\n"
+            "  -d DIR    host directory to serve as the boot volume (default: .)\n"
+            "  -n NVRAM  file in which non-volatile variables persist across runs (default: none)\n"
+            "  -k KEYS   console input, consumed before stdin; a newline is an Enter (default: Enter)\n"
+            "  -m MB     conventional memory reported in the memory map (default: %d)\n"
+            "  -r RUNS   run the image RUNS times and report timing statistics (default: 1)\n"
+            "  -q        suppress console output and diagnostics; timing statistics are still reported\n",
+            Program, DEFAULT_MEMORY_MB);
+}
+
+int main(int argc, char **argv)
+{
+    const char *root = ".", *nvram = NULL, *keys = "\n";
+    long memoryMb = DEFAULT_MEMORY_MB, runs = 1;
+    int option;
+
+    while ((option = getopt(argc, argv, "d:n:k:m:r:qh")) != -1) {
+        switch (option) {
+        case 'd': root = optarg; break;
+        case 'n': nvram = optarg; break;
+        case 'k': keys = optarg; break;
+        case 'm': memoryMb = strtol(optarg, NULL, 0); break;
+        case 'r': runs = strtol(optarg, NULL, 0); break;
+        case 'q': SimQuiet = true; break;
+        default:
+            Usage(argv[0]);
+            return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if (optind != argc || memoryMb <= 0 || runs <= 0 || runs > MAX_RUNS) {
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    EFI_HANDLE image = InitializeFirmware(root, nvram, keys, (UINT64)memoryMb << 20);
+    if (image == NULL)
+        return EXIT_FAILURE;
+
+    UINT64 *durations = calloc((size_t)runs, sizeof(UINT64));
+    EFI_STATUS status = EFI_SUCCESS;
+    for (long run = 0; run < runs; run++) {
+        if (run != 0)
+            ResetConsole(keys);
+        BeginImage();
+        UINT64 start = MonotonicNanoseconds();
+        status = efi_main(image, &SystemTable);
+        durations[run] = MonotonicNanoseconds() - start;
+
+        if (!SimQuiet && OpenFileCount() != 0)
+            fprintf(stderr, "uefisim: image returned with %lu file handle(s) open\n",
+                    (unsigned long)OpenFileCount());
+        if (!SimQuiet)
+            fprintf(stderr, "uefisim: run %ld returned 0x%lx after %.3f ms\n", run + 1, (unsigned long)status,
+                    durations[run] / 1e6);
+        ResetBootServices();
+    }
+
+    if (runs > 1) {
+        qsort(durations, (size_t)runs, sizeof(UINT64), CompareDurations);
+        fprintf(stderr, "uefisim: %ld runs: min %.3f ms, median %.3f ms, p90 %.3f ms, max %.3f ms\n", runs,
+                durations[0] / 1e6, durations[runs / 2] / 1e6, durations[(runs * 9) / 10] / 1e6,
+                durations[runs - 1] / 1e6);
+    }
+    if (nvram != NULL && !SimQuiet)
+        fprintf(stderr, "uefisim: %lu NVRAM write(s)\n", (unsigned long)VariableWrites());
+
+    free(durations);
+    return EFI_ERROR(status) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
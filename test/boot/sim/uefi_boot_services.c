@@ -0,0 +1,943 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : UEFI Boot Services, UEFI Simulator, UEFI Bootloader Test Suite                             //
+// Filename    : uefi_boot_services.c                                                                       //
+// Description : Implements the simulated EFI_BOOT_SERVICES table: pool and page allocation with a memory   //
+//               map, events and timers, the protocol handle database, device path resolution and the       //
+//               miscellaneous services.                                                                    //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "uefi_sim.h"
+
+#define ALLOCATION_MAGIC    0x434F4C41      // 'ALOC'
+#define EVENT_MAGIC         0x544E5645      // 'EVNT'
+#define HANDLE_MAGIC        0x4C444E48      // 'HNDL'
+#define POOL_HEADER_SIZE    ((sizeof(struct Allocation) + 15) & ~(size_t)15)
+#define CONVENTIONAL_BASE   0x100000
+
+struct Allocation {
+    UINT32             Magic;
+    bool               IsPool;
+    EFI_MEMORY_TYPE    Type;
+    UINTN              Size;
+    UINT8             *Base;
+    struct Allocation *Prev;
+    struct Allocation *Next;
+};
+
+struct Event {
+    UINT32            Magic;
+    UINT32            Type;
+    EFI_TPL           NotifyTpl;
+    EFI_EVENT_NOTIFY  NotifyFunction;
+    VOID             *NotifyContext;
+    bool              Signaled;
+    bool              Persistent;
+    EFI_TIMER_DELAY   TimerType;
+    UINT64            Deadline;
+    UINT64            Period;
+    struct Event     *Next;
+};
+
+struct Handle {
+    UINT32         Magic;
+    UINTN          Count;
+    EFI_GUID       Protocols[SIM_MAX_PROTOCOLS];
+    VOID          *Interfaces[SIM_MAX_PROTOCOLS];
+    struct Handle *Next;
+};
+
+static EFI_BOOT_SERVICES *BootServices;
+static struct Allocation *Allocations;
+static struct Event      *Events;
+static struct Handle     *Handles;
+static UINT64             ConventionalPages;
+static UINTN              MapKey = 1;
+static EFI_TPL            CurrentTpl = TPL_APPLICATION;
+static UINT64             MonotonicCount;
+static bool               ImageRunning;
+static bool               Exited;
+
+/// Returns the value of the host monotonic clock in nanoseconds.
+UINT64 MonotonicNanoseconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (UINT64)ts.tv_sec * 1000000000ULL + (UINT64)ts.tv_nsec;
+}
+
+/// Reports (once per service) a boot service called after `ExitBootServices`, which real firmware would not
+/// survive.
+///
+/// @param Name the name of the service
+/// @return     true if boot services are no longer available
+static bool CheckExited(const char *Name)
+{
+    if (Exited)
+        fprintf(stderr, "uefisim: %s called after ExitBootServices\n", Name);
+    return Exited;
+}
+
+static bool GuidEqual(const EFI_GUID *a, const EFI_GUID *b)
+{
+    return memcmp(a, b, sizeof(EFI_GUID)) == 0;
+}
+
+// ---- CRC32 --------------------------------------------------------------------------------------------- //
+
+static EFI_STATUS EFIAPI SimCalculateCrc32(VOID *Data, UINTN DataSize, UINT32 *Crc32)
+{
+    static UINT32 table[256];
+    if (table[1] == 0) {
+        for (UINT32 i = 0; i < 256; i++) {
+            UINT32 c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+            table[i] = c;
+        }
+    }
+    if (Data == NULL || Crc32 == NULL || DataSize == 0)
+        return EFI_INVALID_PARAMETER;
+
+    UINT32 crc = 0xFFFFFFFF;
+    for (UINTN i = 0; i < DataSize; i++)
+        crc = table[(crc ^ ((UINT8 *)Data)[i]) & 0xFF] ^ (crc >> 8);
+    *Crc32 = crc ^ 0xFFFFFFFF;
+    return EFI_SUCCESS;
+}
+
+/// Computes the CRC32 of a service table, as firmware does when publishing it. The `CRC32` field of the
+/// header is zeroed during the computation.
+///
+/// @param Hdr the header of the table; `HeaderSize` must cover the whole table
+/// @return    the CRC32 of the table
+UINT32 CalculateTableCrc(EFI_TABLE_HEADER *Hdr)
+{
+    UINT32 crc = 0;
+    Hdr->CRC32 = 0;
+    SimCalculateCrc32(Hdr, Hdr->HeaderSize, &crc);
+    return crc;
+}
+
+// ---- Task priority levels ------------------------------------------------------------------------------ //
+
+static EFI_TPL EFIAPI SimRaiseTPL(EFI_TPL NewTpl)
+{
+    EFI_TPL old = CurrentTpl;
+    if (NewTpl < old)
+        fprintf(stderr, "uefisim: RaiseTPL to %lu below current TPL %lu\n", (unsigned long)NewTpl,
+                (unsigned long)old);
+    CurrentTpl = NewTpl;
+    return old;
+}
+
+static VOID EFIAPI SimRestoreTPL(EFI_TPL OldTpl)
+{
+    if (OldTpl > CurrentTpl)
+        fprintf(stderr, "uefisim: RestoreTPL to %lu above current TPL %lu\n", (unsigned long)OldTpl,
+                (unsigned long)CurrentTpl);
+    CurrentTpl = OldTpl;
+}
+
+// ---- Memory allocation --------------------------------------------------------------------------------- //
+
+static void LinkAllocation(struct Allocation *a)
+{
+    a->Magic = ALLOCATION_MAGIC;
+    a->Prev = NULL;
+    a->Next = Allocations;
+    if (Allocations != NULL)
+        Allocations->Prev = a;
+    Allocations = a;
+    MapKey++;
+}
+
+static void UnlinkAllocation(struct Allocation *a)
+{
+    if (a->Prev != NULL)
+        a->Prev->Next = a->Next;
+    else
+        Allocations = a->Next;
+    if (a->Next != NULL)
+        a->Next->Prev = a->Prev;
+    a->Magic = 0;
+    MapKey++;
+}
+
+static bool ValidMemoryType(EFI_MEMORY_TYPE Type)
+{
+    return (Type < EfiMaxMemoryType && Type != EfiConventionalMemory && Type != EfiPersistentMemory) ||
+           (UINT32)Type >= 0x70000000;
+}
+
+static EFI_STATUS EFIAPI SimAllocatePool(EFI_MEMORY_TYPE PoolType, UINTN Size, VOID **Buffer)
+{
+    if (CheckExited("AllocatePool"))
+        return EFI_UNSUPPORTED;
+    if (Buffer == NULL || !ValidMemoryType(PoolType))
+        return EFI_INVALID_PARAMETER;
+
+    struct Allocation *a = malloc(POOL_HEADER_SIZE + Size);
+    if (a == NULL)
+        return EFI_OUT_OF_RESOURCES;
+    a->IsPool = true;
+    a->Type = PoolType;
+    a->Size = Size;
+    a->Base = (UINT8 *)a + POOL_HEADER_SIZE;
+    LinkAllocation(a);
+
+    *Buffer = a->Base;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimFreePool(VOID *Buffer)
+{
+    if (CheckExited("FreePool"))
+        return EFI_UNSUPPORTED;
+    if (Buffer == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    // Look the buffer up rather than trusting the header in front of it, so that freeing a stray pointer is
+    // reported instead of faulting.
+    for (struct Allocation *a = Allocations; a != NULL; a = a->Next) {
+        if (!a->IsPool || a->Base != Buffer)
+            continue;
+        UnlinkAllocation(a);
+        free(a);
+        return EFI_SUCCESS;
+    }
+
+    fprintf(stderr, "uefisim: FreePool of %p, which is not a pool allocation\n", Buffer);
+    return EFI_INVALID_PARAMETER;
+}
+
+static EFI_STATUS EFIAPI SimAllocatePages(EFI_ALLOCATE_TYPE Type, EFI_MEMORY_TYPE MemoryType, UINTN Pages,
+                                          EFI_PHYSICAL_ADDRESS *Memory)
+{
+    if (CheckExited("AllocatePages"))
+        return EFI_UNSUPPORTED;
+    if (Memory == NULL || Type >= MaxAllocateType || !ValidMemoryType(MemoryType))
+        return EFI_INVALID_PARAMETER;
+    if (Pages == 0 || Pages > ConventionalPages)
+        return EFI_OUT_OF_RESOURCES;
+
+    UINTN bytes = Pages * EFI_PAGE_SIZE;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    VOID *hint = NULL;
+
+    if (Type == AllocateAddress) {
+        if (*Memory & (EFI_PAGE_SIZE - 1))
+            return EFI_INVALID_PARAMETER;
+        hint = (VOID *)(uintptr_t)*Memory;
+        flags |= MAP_FIXED_NOREPLACE;
+    }
+    else if (Type == AllocateMaxAddress && *Memory <= 0xFFFFFFFFULL) {
+        flags |= MAP_32BIT;
+    }
+
+    VOID *base = mmap(hint, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (base == MAP_FAILED)
+        return (Type == AllocateAnyPages) ? EFI_OUT_OF_RESOURCES : EFI_NOT_FOUND;
+    if ((Type == AllocateAddress && base != hint) ||
+        (Type == AllocateMaxAddress && (uintptr_t)base + bytes - 1 > *Memory)) {
+        munmap(base, bytes);
+        return EFI_NOT_FOUND;
+    }
+
+    struct Allocation *a = malloc(sizeof(struct Allocation));
+    if (a == NULL) {
+        munmap(base, bytes);
+        return EFI_OUT_OF_RESOURCES;
+    }
+    a->IsPool = false;
+    a->Type = MemoryType;
+    a->Size = bytes;
+    a->Base = base;
+    LinkAllocation(a);
+
+    *Memory = (EFI_PHYSICAL_ADDRESS)(uintptr_t)base;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimFreePages(EFI_PHYSICAL_ADDRESS Memory, UINTN Pages)
+{
+    if (CheckExited("FreePages"))
+        return EFI_UNSUPPORTED;
+
+    for (struct Allocation *a = Allocations; a != NULL; a = a->Next) {
+        if (a->IsPool || (uintptr_t)a->Base != Memory)
+            continue;
+        if (a->Size != Pages * EFI_PAGE_SIZE)
+            return EFI_INVALID_PARAMETER;
+        munmap(a->Base, a->Size);
+        UnlinkAllocation(a);
+        free(a);
+        return EFI_SUCCESS;
+    }
+    return EFI_NOT_FOUND;
+}
+
+static int CompareDescriptors(const void *a, const void *b)
+{
+    const EFI_MEMORY_DESCRIPTOR *x = a, *y = b;
+    return (x->PhysicalStart > y->PhysicalStart) - (x->PhysicalStart < y->PhysicalStart);
+}
+
+static EFI_STATUS EFIAPI SimGetMemoryMap(UINTN *MemoryMapSize, EFI_MEMORY_DESCRIPTOR *MemoryMap, UINTN *Key,
+                                         UINTN *DescriptorSize, UINT32 *DescriptorVersion)
+{
+    if (CheckExited("GetMemoryMap"))
+        return EFI_UNSUPPORTED;
+    if (MemoryMapSize == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    UINTN allocations = 0;
+    for (struct Allocation *a = Allocations; a != NULL; a = a->Next)
+        allocations++;
+
+    // Build the descriptors densely and sort them by address. Each allocation can split the conventional
+    // range at most once more, so there are never more than 2n + 1 descriptors.
+    EFI_MEMORY_DESCRIPTOR *dense = malloc((2 * allocations + 1) * sizeof(EFI_MEMORY_DESCRIPTOR));
+    if (dense == NULL)
+        return EFI_OUT_OF_RESOURCES;
+
+    UINTN count = 0;
+    for (struct Allocation *a = Allocations; a != NULL; a = a->Next, count++) {
+        UINT64 start = (uintptr_t)a->Base & ~(UINT64)(EFI_PAGE_SIZE - 1);
+        UINT64 end = (uintptr_t)a->Base + a->Size;
+        dense[count] = (EFI_MEMORY_DESCRIPTOR){ a->Type, start, 0, EFI_SIZE_TO_PAGES(end - start),
+                                                EFI_MEMORY_WB };
+    }
+    qsort(dense, count, sizeof(EFI_MEMORY_DESCRIPTOR), CompareDescriptors);
+
+    // Pool allocations share pages, so rounding each one out to whole pages leaves ranges which overlap.
+    // Merge ranges of the same type which overlap or abut; a page shared by allocations of different types
+    // is reported once, with the type of the allocation below it.
+    UINTN ranges = 0;
+    for (UINTN i = 0; i < count; i++) {
+        UINT64 start = dense[i].PhysicalStart;
+        UINT64 end = start + dense[i].NumberOfPages * EFI_PAGE_SIZE;
+        if (ranges > 0) {
+            EFI_MEMORY_DESCRIPTOR *last = &dense[ranges - 1];
+            UINT64 lastEnd = last->PhysicalStart + last->NumberOfPages * EFI_PAGE_SIZE;
+            if (start <= lastEnd && dense[i].Type == last->Type) {
+                if (end > lastEnd)
+                    last->NumberOfPages = (end - last->PhysicalStart) / EFI_PAGE_SIZE;
+                continue;
+            }
+            if (end <= lastEnd)
+                continue;
+            if (start < lastEnd)
+                start = lastEnd;
+        }
+        dense[ranges++] = (EFI_MEMORY_DESCRIPTOR){ dense[i].Type, start, 0, (end - start) / EFI_PAGE_SIZE,
+                                                   EFI_MEMORY_WB };
+    }
+    count = ranges;
+
+    // Report the conventional range with the allocations carved out of it, as firmware would; host mappings
+    // can land inside it (MAP_32BIT pages in particular), and free and allocated memory must never overlap.
+    UINT64 cursor = CONVENTIONAL_BASE;
+    UINT64 limit = CONVENTIONAL_BASE + ConventionalPages * EFI_PAGE_SIZE;
+    for (UINTN i = 0; i < ranges && cursor < limit; i++) {
+        UINT64 start = dense[i].PhysicalStart;
+        UINT64 end = start + dense[i].NumberOfPages * EFI_PAGE_SIZE;
+        UINT64 gap = ((start < limit) ? start : limit) - cursor;
+        if (start > cursor)
+            dense[count++] = (EFI_MEMORY_DESCRIPTOR){ EfiConventionalMemory, cursor, 0, gap / EFI_PAGE_SIZE,
+                                                      EFI_MEMORY_WB };
+        if (end > cursor)
+            cursor = end;
+    }
+    if (cursor < limit)
+        dense[count++] = (EFI_MEMORY_DESCRIPTOR){ EfiConventionalMemory, cursor, 0,
+                                                  (limit - cursor) / EFI_PAGE_SIZE, EFI_MEMORY_WB };
+    qsort(dense, count, sizeof(EFI_MEMORY_DESCRIPTOR), CompareDescriptors);
+
+    if (DescriptorSize != NULL)
+        *DescriptorSize = SIM_DESCRIPTOR_SIZE;
+    if (DescriptorVersion != NULL)
+        *DescriptorVersion = 1;
+    if (*MemoryMapSize < count * SIM_DESCRIPTOR_SIZE) {
+        *MemoryMapSize = count * SIM_DESCRIPTOR_SIZE;
+        free(dense);
+        return EFI_BUFFER_TOO_SMALL;
+    }
+    if (MemoryMap == NULL || Key == NULL) {
+        free(dense);
+        return EFI_INVALID_PARAMETER;
+    }
+
+    // Spread the descriptors out to the reported stride.
+    memset(MemoryMap, 0, count * SIM_DESCRIPTOR_SIZE);
+    for (UINTN i = 0; i < count; i++)
+        memcpy((UINT8 *)MemoryMap + i * SIM_DESCRIPTOR_SIZE, &dense[i], sizeof(EFI_MEMORY_DESCRIPTOR));
+    free(dense);
+
+    *MemoryMapSize = count * SIM_DESCRIPTOR_SIZE;
+    *Key = MapKey;
+    return EFI_SUCCESS;
+}
+
+/// Lists the allocations still outstanding and optionally releases them. Used after the image returns, both
+/// to point out leaks and to give repeated runs a clean heap.
+///
+/// @param Release whether the allocations should be freed
+/// @return        the number of outstanding allocations
+UINTN ReportAllocations(bool Release)
+{
+    UINTN count = 0, bytes = 0;
+
+    for (struct Allocation *a = Allocations, *next; a != NULL; a = next) {
+        next = a->Next;
+        count++;
+        bytes += a->Size;
+        if (!SimQuiet)
+            fprintf(stderr, "uefisim: outstanding %s allocation of %lu bytes (type %u) at %p\n",
+                    a->IsPool ? "pool" : "page", (unsigned long)a->Size, (unsigned)a->Type, (VOID *)a->Base);
+        if (Release) {
+            UnlinkAllocation(a);
+            if (a->IsPool) {
+                free(a);
+            }
+            else {
+                munmap(a->Base, a->Size);
+                free(a);
+            }
+        }
+    }
+
+    if (count > 0 && !SimQuiet)
+        fprintf(stderr, "uefisim: %lu allocation(s), %lu bytes outstanding\n", (unsigned long)count,
+                (unsigned long)bytes);
+    return count;
+}
+
+// ---- Events and timers --------------------------------------------------------------------------------- //
+
+static struct Event *ToEvent(EFI_EVENT Event)
+{
+    for (struct Event *e = Events; e != NULL; e = e->Next) {
+        if (e == Event && e->Magic == EVENT_MAGIC)
+            return e;
+    }
+    return NULL;
+}
+
+static void Signal(struct Event *e)
+{
+    if (e->Type & EVT_NOTIFY_SIGNAL) {
+        // Signal-type events have their notification function run, but can never be waited upon.
+        EFI_TPL old = CurrentTpl;
+        CurrentTpl = e->NotifyTpl;
+        e->NotifyFunction(e, e->NotifyContext);
+        CurrentTpl = old;
+    }
+    else {
+        e->Signaled = true;
+    }
+}
+
+static void UpdateTimers(void)
+{
+    UINT64 now = MonotonicNanoseconds();
+    for (struct Event *e = Events; e != NULL; e = e->Next) {
+        if (e->TimerType == TimerCancel || now < e->Deadline)
+            continue;
+        if (e->TimerType == TimerPeriodic && e->Period > 0)
+            e->Deadline += ((now - e->Deadline) / e->Period + 1) * e->Period;
+        else
+            e->TimerType = TimerCancel;
+        Signal(e);
+    }
+}
+
+static EFI_STATUS EFIAPI SimCreateEvent(UINT32 Type, EFI_TPL NotifyTpl, EFI_EVENT_NOTIFY NotifyFunction,
+                                        VOID *NotifyContext, EFI_EVENT *Event)
+{
+    if (CheckExited("CreateEvent"))
+        return EFI_UNSUPPORTED;
+    if (Event == NULL || ((Type & EVT_NOTIFY_WAIT) && (Type & EVT_NOTIFY_SIGNAL)))
+        return EFI_INVALID_PARAMETER;
+    if ((Type & (EVT_NOTIFY_WAIT | EVT_NOTIFY_SIGNAL)) &&
+        (NotifyFunction == NULL || NotifyTpl <= TPL_APPLICATION || NotifyTpl > TPL_HIGH_LEVEL))
+        return EFI_INVALID_PARAMETER;
+
+    struct Event *e = calloc(1, sizeof(struct Event));
+    if (e == NULL)
+        return EFI_OUT_OF_RESOURCES;
+    e->Magic = EVENT_MAGIC;
+    e->Type = Type;
+    e->NotifyTpl = NotifyTpl;
+    e->NotifyFunction = NotifyFunction;
+    e->NotifyContext = NotifyContext;
+    e->TimerType = TimerCancel;
+    e->Persistent = !ImageRunning;
+    e->Next = Events;
+    Events = e;
+
+    *Event = e;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimSetTimer(EFI_EVENT Event, EFI_TIMER_DELAY Type, UINT64 TriggerTime)
+{
+    if (CheckExited("SetTimer"))
+        return EFI_UNSUPPORTED;
+
+    struct Event *e = ToEvent(Event);
+    if (e == NULL || !(e->Type & EVT_TIMER) || Type > TimerRelative)
+        return EFI_INVALID_PARAMETER;
+
+    // TriggerTime is in 100ns units.
+    e->TimerType = Type;
+    e->Period = (Type == TimerPeriodic) ? TriggerTime * 100 : 0;
+    e->Deadline = MonotonicNanoseconds() + TriggerTime * 100;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimSignalEvent(EFI_EVENT Event)
+{
+    if (CheckExited("SignalEvent"))
+        return EFI_UNSUPPORTED;
+
+    struct Event *e = ToEvent(Event);
+    if (e == NULL)
+        return EFI_INVALID_PARAMETER;
+    Signal(e);
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimCheckEvent(EFI_EVENT Event)
+{
+    struct Event *e = ToEvent(Event);
+    if (e == NULL || (e->Type & EVT_NOTIFY_SIGNAL))
+        return EFI_INVALID_PARAMETER;
+
+    UpdateTimers();
+    if (!e->Signaled && (e->Type & EVT_NOTIFY_WAIT)) {
+        EFI_TPL old = CurrentTpl;
+        CurrentTpl = e->NotifyTpl;
+        e->NotifyFunction(e, e->NotifyContext);
+        CurrentTpl = old;
+    }
+    if (!e->Signaled)
+        return EFI_NOT_READY;
+
+    e->Signaled = false;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimWaitForEvent(UINTN NumberOfEvents, EFI_EVENT *Event, UINTN *Index)
+{
+    if (CheckExited("WaitForEvent"))
+        return EFI_UNSUPPORTED;
+    if (NumberOfEvents == 0 || Event == NULL || Index == NULL)
+        return EFI_INVALID_PARAMETER;
+    if (CurrentTpl != TPL_APPLICATION)
+        return EFI_UNSUPPORTED;
+
+    for (;;) {
+        for (UINTN i = 0; i < NumberOfEvents; i++) {
+            EFI_STATUS status = SimCheckEvent(Event[i]);
+            if (status != EFI_NOT_READY) {
+                *Index = i;
+                return status;
+            }
+        }
+
+        struct timespec pause = { 0, 100000 };
+        nanosleep(&pause, NULL);
+    }
+}
+
+static EFI_STATUS EFIAPI SimCloseEvent(EFI_EVENT Event)
+{
+    for (struct Event **link = &Events; *link != NULL; link = &(*link)->Next) {
+        if (*link == Event && (*link)->Magic == EVENT_MAGIC) {
+            struct Event *e = *link;
+            *link = e->Next;
+            e->Magic = 0;
+            free(e);
+            return EFI_SUCCESS;
+        }
+    }
+    return EFI_INVALID_PARAMETER;
+}
+
+// ---- Protocol handle database -------------------------------------------------------------------------- //
+
+static struct Handle *ToHandle(EFI_HANDLE Handle)
+{
+    for (struct Handle *h = Handles; h != NULL; h = h->Next) {
+        if (h == Handle && h->Magic == HANDLE_MAGIC)
+            return h;
+    }
+    return NULL;
+}
+
+static VOID *FindProtocol(struct Handle *h, EFI_GUID *Protocol)
+{
+    for (UINTN i = 0; i < h->Count; i++) {
+        if (GuidEqual(&h->Protocols[i], Protocol))
+            return h->Interfaces[i];
+    }
+    return NULL;
+}
+
+static EFI_STATUS EFIAPI SimInstallProtocolInterface(EFI_HANDLE *Handle, EFI_GUID *Protocol,
+                                                     EFI_INTERFACE_TYPE InterfaceType, VOID *Interface)
+{
+    if (CheckExited("InstallProtocolInterface"))
+        return EFI_UNSUPPORTED;
+    if (Handle == NULL || Protocol == NULL || InterfaceType != EFI_NATIVE_INTERFACE)
+        return EFI_INVALID_PARAMETER;
+
+    struct Handle *h;
+    if (*Handle == NULL) {
+        h = calloc(1, sizeof(struct Handle));
+        if (h == NULL)
+            return EFI_OUT_OF_RESOURCES;
+        h->Magic = HANDLE_MAGIC;
+
+        // Append, so that handles enumerate in creation order as they tend to on real firmware.
+        struct Handle **link = &Handles;
+        while (*link != NULL)
+            link = &(*link)->Next;
+        *link = h;
+        *Handle = h;
+    }
+    else if ((h = ToHandle(*Handle)) == NULL) {
+        return EFI_INVALID_PARAMETER;
+    }
+
+    if (FindProtocol(h, Protocol) != NULL)
+        return EFI_INVALID_PARAMETER;
+    if (h->Count == SIM_MAX_PROTOCOLS)
+        return EFI_OUT_OF_RESOURCES;
+    h->Protocols[h->Count] = *Protocol;
+    h->Interfaces[h->Count] = Interface;
+    h->Count++;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimHandleProtocol(EFI_HANDLE Handle, EFI_GUID *Protocol, VOID **Interface)
+{
+    if (CheckExited("HandleProtocol"))
+        return EFI_UNSUPPORTED;
+
+    struct Handle *h = ToHandle(Handle);
+    if (h == NULL || Protocol == NULL || Interface == NULL)
+        return EFI_INVALID_PARAMETER;
+    for (UINTN i = 0; i < h->Count; i++) {
+        if (GuidEqual(&h->Protocols[i], Protocol)) {
+            *Interface = h->Interfaces[i];
+            return EFI_SUCCESS;
+        }
+    }
+    *Interface = NULL;
+    return EFI_UNSUPPORTED;
+}
+
+static EFI_STATUS EFIAPI SimOpenProtocol(EFI_HANDLE Handle, EFI_GUID *Protocol, VOID **Interface,
+                                         EFI_HANDLE AgentHandle, EFI_HANDLE ControllerHandle,
+                                         UINT32 Attributes)
+{
+    VOID *unused;
+    (void)AgentHandle;
+    (void)ControllerHandle;
+    (void)Attributes;
+    return SimHandleProtocol(Handle, Protocol, (Interface != NULL) ? Interface : &unused);
+}
+
+static EFI_STATUS EFIAPI SimCloseProtocol(EFI_HANDLE Handle, EFI_GUID *Protocol, EFI_HANDLE AgentHandle,
+                                          EFI_HANDLE ControllerHandle)
+{
+    (void)AgentHandle;
+    (void)ControllerHandle;
+    struct Handle *h = ToHandle(Handle);
+    if (h == NULL || Protocol == NULL)
+        return EFI_INVALID_PARAMETER;
+    return (FindProtocol(h, Protocol) != NULL) ? EFI_SUCCESS : EFI_NOT_FOUND;
+}
+
+static bool MatchesSearch(struct Handle *h, EFI_LOCATE_SEARCH_TYPE SearchType, EFI_GUID *Protocol)
+{
+    return SearchType == AllHandles || FindProtocol(h, Protocol) != NULL;
+}
+
+static EFI_STATUS EFIAPI SimLocateHandle(EFI_LOCATE_SEARCH_TYPE SearchType, EFI_GUID *Protocol,
+                                         VOID *SearchKey, UINTN *BufferSize, EFI_HANDLE *Buffer)
+{
+    (void)SearchKey;
+    if (CheckExited("LocateHandle"))
+        return EFI_UNSUPPORTED;
+    if (SearchType == ByRegisterNotify)
+        return EFI_UNSUPPORTED;
+    if (BufferSize == NULL || SearchType > ByProtocol || (SearchType == ByProtocol && Protocol == NULL))
+        return EFI_INVALID_PARAMETER;
+
+    UINTN count = 0;
+    for (struct Handle *h = Handles; h != NULL; h = h->Next)
+        count += MatchesSearch(h, SearchType, Protocol);
+    if (count == 0)
+        return EFI_NOT_FOUND;
+    if (*BufferSize < count * sizeof(EFI_HANDLE)) {
+        *BufferSize = count * sizeof(EFI_HANDLE);
+        return EFI_BUFFER_TOO_SMALL;
+    }
+    if (Buffer == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    UINTN i = 0;
+    for (struct Handle *h = Handles; h != NULL; h = h->Next) {
+        if (MatchesSearch(h, SearchType, Protocol))
+            Buffer[i++] = h;
+    }
+    *BufferSize = count * sizeof(EFI_HANDLE);
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimLocateHandleBuffer(EFI_LOCATE_SEARCH_TYPE SearchType, EFI_GUID *Protocol,
+                                               VOID *SearchKey, UINTN *NoHandles, EFI_HANDLE **Buffer)
+{
+    UINTN size = 0;
+    if (NoHandles == NULL || Buffer == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    EFI_STATUS status = SimLocateHandle(SearchType, Protocol, SearchKey, &size, NULL);
+    if (status != EFI_BUFFER_TOO_SMALL)
+        return status;
+    status = SimAllocatePool(EfiBootServicesData, size, (VOID **)Buffer);
+    if (EFI_ERROR(status))
+        return status;
+    status = SimLocateHandle(SearchType, Protocol, SearchKey, &size, *Buffer);
+    *NoHandles = size / sizeof(EFI_HANDLE);
+    return status;
+}
+
+static EFI_STATUS EFIAPI SimLocateProtocol(EFI_GUID *Protocol, VOID *Registration, VOID **Interface)
+{
+    (void)Registration;
+    if (CheckExited("LocateProtocol"))
+        return EFI_UNSUPPORTED;
+    if (Protocol == NULL || Interface == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    for (struct Handle *h = Handles; h != NULL; h = h->Next) {
+        for (UINTN i = 0; i < h->Count; i++) {
+            if (GuidEqual(&h->Protocols[i], Protocol)) {
+                *Interface = h->Interfaces[i];
+                return EFI_SUCCESS;
+            }
+        }
+    }
+    *Interface = NULL;
+    return EFI_NOT_FOUND;
+}
+
+/// Returns the number of bytes of `Path` (a complete device path) which prefix `Target` on whole-node
+/// boundaries, or zero if `Path` is not a prefix of `Target`.
+static UINTN MatchDevicePath(EFI_DEVICE_PATH *Path, EFI_DEVICE_PATH *Target)
+{
+    UINTN matched = 0;
+    while (!IsDevicePathEnd(Path)) {
+        UINTN length = DevicePathNodeLength(Path);
+        if (IsDevicePathEnd(Target) || DevicePathNodeLength(Target) != length ||
+            memcmp(Path, Target, length) != 0)
+            return 0;
+        matched += length;
+        Path = NextDevicePathNode(Path);
+        Target = NextDevicePathNode(Target);
+    }
+    return matched;
+}
+
+static EFI_STATUS EFIAPI SimLocateDevicePath(EFI_GUID *Protocol, EFI_DEVICE_PATH **DevicePath,
+                                             EFI_HANDLE *Device)
+{
+    static EFI_GUID devicePathGuid = EFI_DEVICE_PATH_PROTOCOL_GUID;
+    struct Handle *best = NULL;
+    UINTN bestLength = 0;
+
+    if (CheckExited("LocateDevicePath"))
+        return EFI_UNSUPPORTED;
+    if (Protocol == NULL || DevicePath == NULL || *DevicePath == NULL || Device == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    for (struct Handle *h = Handles; h != NULL; h = h->Next) {
+        EFI_DEVICE_PATH *path = FindProtocol(h, &devicePathGuid);
+        if (path == NULL || FindProtocol(h, Protocol) == NULL)
+            continue;
+        UINTN length = MatchDevicePath(path, *DevicePath);
+        if (length > bestLength) {
+            best = h;
+            bestLength = length;
+        }
+    }
+    if (best == NULL)
+        return EFI_NOT_FOUND;
+
+    *Device = best;
+    *DevicePath = (EFI_DEVICE_PATH *)((UINT8 *)*DevicePath + bestLength);
+    return EFI_SUCCESS;
+}
+
+// ---- Image services and miscellaneous ------------------------------------------------------------------ //
+
+static EFI_STATUS EFIAPI SimExitBootServices(EFI_HANDLE ImageHandle, UINTN Key)
+{
+    (void)ImageHandle;
+    if (Exited)
+        return EFI_INVALID_PARAMETER;
+    if (Key != MapKey)
+        return EFI_INVALID_PARAMETER;
+    Exited = true;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimGetNextMonotonicCount(UINT64 *Count)
+{
+    if (CheckExited("GetNextMonotonicCount"))
+        return EFI_UNSUPPORTED;
+    if (Count == NULL)
+        return EFI_INVALID_PARAMETER;
+    *Count = ++MonotonicCount;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimStall(UINTN Microseconds)
+{
+    if (CheckExited("Stall"))
+        return EFI_UNSUPPORTED;
+    struct timespec ts = { (time_t)(Microseconds / 1000000), (long)(Microseconds % 1000000) * 1000 };
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+        ;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimSetWatchdogTimer(UINTN Timeout, UINT64 WatchdogCode, UINTN DataSize,
+                                             CHAR16 *WatchdogData)
+{
+    (void)Timeout;
+    (void)WatchdogCode;
+    (void)DataSize;
+    (void)WatchdogData;
+    return CheckExited("SetWatchdogTimer") ? EFI_UNSUPPORTED : EFI_SUCCESS;
+}
+
+static VOID EFIAPI SimCopyMem(VOID *Destination, VOID *Source, UINTN Length)
+{
+    memmove(Destination, Source, Length);
+}
+
+static VOID EFIAPI SimSetMem(VOID *Buffer, UINTN Size, UINT8 Value)
+{
+    memset(Buffer, Value, Size);
+}
+
+/// Fills in the boot services table.
+///
+/// @param BS                the table to initialize
+/// @param ConventionalBytes the amount of free memory to report in the memory map
+void InitializeBootServices(EFI_BOOT_SERVICES *BS, UINT64 ConventionalBytes)
+{
+    memset(BS, 0, sizeof(EFI_BOOT_SERVICES));
+    BS->Hdr.Signature = EFI_BOOT_SERVICES_SIGNATURE;
+    BS->Hdr.Revision = EFI_SPECIFICATION_VERSION;
+    BS->Hdr.HeaderSize = sizeof(EFI_BOOT_SERVICES);
+
+    BS->RaiseTPL = SimRaiseTPL;
+    BS->RestoreTPL = SimRestoreTPL;
+    BS->AllocatePages = SimAllocatePages;
+    BS->FreePages = SimFreePages;
+    BS->GetMemoryMap = SimGetMemoryMap;
+    BS->AllocatePool = SimAllocatePool;
+    BS->FreePool = SimFreePool;
+    BS->CreateEvent = SimCreateEvent;
+    BS->SetTimer = SimSetTimer;
+    BS->WaitForEvent = SimWaitForEvent;
+    BS->SignalEvent = SimSignalEvent;
+    BS->CloseEvent = SimCloseEvent;
+    BS->CheckEvent = SimCheckEvent;
+    BS->InstallProtocolInterface = SimInstallProtocolInterface;
+    BS->HandleProtocol = SimHandleProtocol;
+    BS->LocateHandle = SimLocateHandle;
+    BS->LocateDevicePath = SimLocateDevicePath;
+    BS->ExitBootServices = SimExitBootServices;
+    BS->GetNextMonotonicCount = SimGetNextMonotonicCount;
+    BS->Stall = SimStall;
+    BS->SetWatchdogTimer = SimSetWatchdogTimer;
+    BS->OpenProtocol = SimOpenProtocol;
+    BS->CloseProtocol = SimCloseProtocol;
+    BS->LocateHandleBuffer = SimLocateHandleBuffer;
+    BS->LocateProtocol = SimLocateProtocol;
+    BS->CalculateCrc32 = SimCalculateCrc32;
+    BS->CopyMem = SimCopyMem;
+    BS->SetMem = SimSetMem;
+    BS->Hdr.CRC32 = CalculateTableCrc(&BS->Hdr);
+
+    BootServices = BS;
+    ConventionalPages = ConventionalBytes / EFI_PAGE_SIZE;
+}
+
+/// Marks the start of an image run. Events created from here on belong to the image and are closed by
+/// `ResetBootServices`.
+void BeginImage(void)
+{
+    ImageRunning = true;
+}
+
+/// Returns the boot services to their initial state after an image run: outstanding allocations and the
+/// image's events are released, and `ExitBootServices` is undone.
+void ResetBootServices(void)
+{
+    ReportAllocations(true);
+    for (struct Event **link = &Events; *link != NULL;) {
+        struct Event *e = *link;
+        if (e->Persistent) {
+            e->Signaled = false;
+            link = &e->Next;
+            continue;
+        }
+        *link = e->Next;
+        e->Magic = 0;
+        free(e);
+    }
+    ImageRunning = false;
+    Exited = false;
+    CurrentTpl = TPL_APPLICATION;
+}
+
+/// Returns whether the image has called `ExitBootServices`.
+bool BootServicesExited(void)
+{
+    return Exited;
+}
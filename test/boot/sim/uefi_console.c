@@ -0,0 +1,277 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : UEFI Console, UEFI Simulator, UEFI Bootloader Test Suite                                   //
+// Filename    : uefi_console.c                                                                             //
+// Description : Implements the simulated console: ConOut and StdErr write UTF-8 to the host's standard     //
+//               output and standard error, and ConIn delivers scripted keystrokes followed by the host's   //
+//               standard input.                                                                            //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "uefi_sim.h"
+
+#define KEY_QUEUE_SIZE          256
+#define CHAR_BACKSPACE          0x0008
+#define CHAR_CARRIAGE_RETURN    0x000D
+#define SCAN_ESC                0x0017
+
+struct TextOutput {
+    SIMPLE_TEXT_OUTPUT_INTERFACE Protocol;
+    SIMPLE_TEXT_OUTPUT_MODE      Mode;
+    FILE                        *Stream;
+};
+
+static struct TextOutput      ConOut;
+static struct TextOutput      StdErr;
+static SIMPLE_INPUT_INTERFACE ConIn;
+static EFI_BOOT_SERVICES     *BootServices;
+static EFI_INPUT_KEY          KeyQueue[KEY_QUEUE_SIZE];
+static UINTN                  KeyHead;
+static UINTN                  KeyTail;
+
+// ---- Text output --------------------------------------------------------------------------------------- //
+
+static EFI_STATUS EFIAPI TextReset(SIMPLE_TEXT_OUTPUT_INTERFACE *This, BOOLEAN ExtendedVerification)
+{
+    (void)ExtendedVerification;
+    This->Mode->CursorColumn = 0;
+    This->Mode->CursorRow = 0;
+    return EFI_SUCCESS;
+}
+
+/// Writes a CHAR16 string to the host stream as UTF-8, tracking the cursor position as firmware would.
+static EFI_STATUS EFIAPI TextOutputString(SIMPLE_TEXT_OUTPUT_INTERFACE *This, CHAR16 *String)
+{
+    struct TextOutput *out = (struct TextOutput *)This;
+    static bool warned;
+
+    if (String == NULL)
+        return EFI_INVALID_PARAMETER;
+    if (BootServicesExited() && !warned) {
+        fprintf(stderr, "uefisim: console output after ExitBootServices\n");
+        warned = true;
+    }
+
+    for (; *String != 0; String++) {
+        CHAR16 c = *String;
+        UINT8 bytes[3];
+        size_t n;
+
+        if (c < 0x80) {
+            bytes[0] = (UINT8)c;
+            n = 1;
+        }
+        else if (c < 0x800) {
+            bytes[0] = (UINT8)(0xC0 | (c >> 6));
+            bytes[1] = (UINT8)(0x80 | (c & 0x3F));
+            n = 2;
+        }
+        else {
+            bytes[0] = (UINT8)(0xE0 | (c >> 12));
+            bytes[1] = (UINT8)(0x80 | ((c >> 6) & 0x3F));
+            bytes[2] = (UINT8)(0x80 | (c & 0x3F));
+            n = 3;
+        }
+        if (!SimQuiet)
+            fwrite(bytes, 1, n, out->Stream);
+
+        if (c == '\r')
+            This->Mode->CursorColumn = 0;
+        else if (c == '\n')
+            This->Mode->CursorRow++;
+        else if (c == CHAR_BACKSPACE && This->Mode->CursorColumn > 0)
+            This->Mode->CursorColumn--;
+        else if (c >= 0x20)
+            This->Mode->CursorColumn++;
+    }
+
+    if (!SimQuiet)
+        fflush(out->Stream);
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI TextTestString(SIMPLE_TEXT_OUTPUT_INTERFACE *This, CHAR16 *String)
+{
+    (void)This;
+    return (String != NULL) ? EFI_SUCCESS : EFI_INVALID_PARAMETER;
+}
+
+static EFI_STATUS EFIAPI TextQueryMode(SIMPLE_TEXT_OUTPUT_INTERFACE *This, UINTN ModeNumber, UINTN *Columns,
+                                       UINTN *Rows)
+{
+    if (ModeNumber >= (UINTN)This->Mode->MaxMode)
+        return EFI_UNSUPPORTED;
+    *Columns = 80;
+    *Rows = 25;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI TextSetMode(SIMPLE_TEXT_OUTPUT_INTERFACE *This, UINTN ModeNumber)
+{
+    if (ModeNumber >= (UINTN)This->Mode->MaxMode)
+        return EFI_UNSUPPORTED;
+    This->Mode->Mode = (INT32)ModeNumber;
+    return TextReset(This, FALSE);
+}
+
+static EFI_STATUS EFIAPI TextSetAttribute(SIMPLE_TEXT_OUTPUT_INTERFACE *This, UINTN Attribute)
+{
+    This->Mode->Attribute = (INT32)Attribute;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI TextClearScreen(SIMPLE_TEXT_OUTPUT_INTERFACE *This)
+{
+    struct TextOutput *out = (struct TextOutput *)This;
+    if (!SimQuiet && isatty(fileno(out->Stream)))
+        fputs("\033[2J\033[H", out->Stream);
+    return TextReset(This, FALSE);
+}
+
+static EFI_STATUS EFIAPI TextSetCursorPosition(SIMPLE_TEXT_OUTPUT_INTERFACE *This, UINTN Column, UINTN Row)
+{
+    if (Column >= 80 || Row >= 25)
+        return EFI_UNSUPPORTED;
+    This->Mode->CursorColumn = (INT32)Column;
+    This->Mode->CursorRow = (INT32)Row;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI TextEnableCursor(SIMPLE_TEXT_OUTPUT_INTERFACE *This, BOOLEAN Visible)
+{
+    This->Mode->CursorVisible = Visible;
+    return EFI_SUCCESS;
+}
+
+static void InitializeTextOutput(struct TextOutput *Out, FILE *Stream)
+{
+    memset(Out, 0, sizeof(struct TextOutput));
+    Out->Protocol.Reset = TextReset;
+    Out->Protocol.OutputString = TextOutputString;
+    Out->Protocol.TestString = TextTestString;
+    Out->Protocol.QueryMode = TextQueryMode;
+    Out->Protocol.SetMode = TextSetMode;
+    Out->Protocol.SetAttribute = TextSetAttribute;
+    Out->Protocol.ClearScreen = TextClearScreen;
+    Out->Protocol.SetCursorPosition = TextSetCursorPosition;
+    Out->Protocol.EnableCursor = TextEnableCursor;
+    Out->Protocol.Mode = &Out->Mode;
+    Out->Mode.MaxMode = 1;
+    Out->Mode.Attribute = 0x07;
+    Out->Mode.CursorVisible = TRUE;
+    Out->Stream = Stream;
+}
+
+// ---- Text input ---------------------------------------------------------------------------------------- //
+
+static bool StandardInputReady(void)
+{
+    struct pollfd fd = { STDIN_FILENO, POLLIN, 0 };
+    return poll(&fd, 1, 0) > 0;
+}
+
+static EFI_STATUS EFIAPI InputReset(SIMPLE_INPUT_INTERFACE *This, BOOLEAN ExtendedVerification)
+{
+    (void)This;
+    (void)ExtendedVerification;
+    return EFI_SUCCESS;
+}
+
+/// Returns the next scripted keystroke, or failing that the next byte of standard input. End of input is
+/// reported as a device error, so that an image polling for a key does not spin forever.
+static EFI_STATUS EFIAPI InputReadKeyStroke(SIMPLE_INPUT_INTERFACE *This, EFI_INPUT_KEY *Key)
+{
+    (void)This;
+    if (Key == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    if (KeyHead != KeyTail) {
+        *Key = KeyQueue[KeyHead];
+        KeyHead = (KeyHead + 1) % KEY_QUEUE_SIZE;
+        return EFI_SUCCESS;
+    }
+    if (!StandardInputReady())
+        return EFI_NOT_READY;
+
+    unsigned char c;
+    if (read(STDIN_FILENO, &c, 1) != 1)
+        return EFI_DEVICE_ERROR;
+
+    *Key = (EFI_INPUT_KEY){ 0, c };
+    if (c == '\n')
+        Key->UnicodeChar = CHAR_CARRIAGE_RETURN;
+    else if (c == 0x7F)
+        Key->UnicodeChar = CHAR_BACKSPACE;
+    else if (c == 0x1B)
+        *Key = (EFI_INPUT_KEY){ SCAN_ESC, 0 };
+    return EFI_SUCCESS;
+}
+
+static VOID EFIAPI WaitForKeyNotify(EFI_EVENT Event, VOID *Context)
+{
+    (void)Context;
+    if (KeyHead != KeyTail || StandardInputReady())
+        BootServices->SignalEvent(Event);
+}
+
+/// Replaces the pending scripted keystrokes. A newline in `Keys` is delivered as a carriage return, matching
+/// the Enter key on real firmware.
+///
+/// @param Keys the keystrokes to deliver before standard input is consulted
+void ResetConsole(const char *Keys)
+{
+    KeyHead = KeyTail = 0;
+    for (; Keys != NULL && *Keys != '\0' && (KeyTail + 1) % KEY_QUEUE_SIZE != KeyHead; Keys++) {
+        CHAR16 c = (*Keys == '\n') ? CHAR_CARRIAGE_RETURN : (CHAR16)(unsigned char)*Keys;
+        KeyQueue[KeyTail] = (EFI_INPUT_KEY){ 0, c };
+        KeyTail = (KeyTail + 1) % KEY_QUEUE_SIZE;
+    }
+
+    TextReset(&ConOut.Protocol, FALSE);
+    TextReset(&StdErr.Protocol, FALSE);
+}
+
+/// Installs ConIn, ConOut and StdErr into the system table. The boot services must already be initialized,
+/// as the WaitForKey event is created through them.
+///
+/// @param ST   the system table
+/// @param Keys the keystrokes to deliver before standard input is consulted
+void InitializeConsole(EFI_SYSTEM_TABLE *ST, const char *Keys)
+{
+    BootServices = ST->BootServices;
+
+    InitializeTextOutput(&ConOut, stdout);
+    InitializeTextOutput(&StdErr, stderr);
+    ConIn.Reset = InputReset;
+    ConIn.ReadKeyStroke = InputReadKeyStroke;
+    BootServices->CreateEvent(EVT_NOTIFY_WAIT, TPL_NOTIFY, WaitForKeyNotify, NULL, &ConIn.WaitForKey);
+
+    ST->ConIn = &ConIn;
+    ST->ConOut = &ConOut.Protocol;
+    ST->StdErr = &StdErr.Protocol;
+    ResetConsole(Keys);
+}
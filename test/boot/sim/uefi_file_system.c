@@ -0,0 +1,651 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : Simple File System, UEFI Simulator, UEFI Bootloader Test Suite                             //
+// Filename    : uefi_file_system.c                                                                         //
+// Description : Implements EFI_SIMPLE_FILE_SYSTEM_PROTOCOL and EFI_FILE_PROTOCOL over a host directory, so //
+//               that the image under test reads its files exactly as it would from the EFI system          //
+//               partition. Lookups are case-insensitive, as on FAT.                                        //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#define _GNU_SOURCE
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "uefi_sim.h"
+
+#define FILE_PROTOCOL_REVISION          0x00010000
+#define SIMPLE_FILE_SYSTEM_REVISION     0x00010000
+#define MAX_FILE_PATH                   4096
+
+#define SIM_VOLUME_GUID \
+    { 0x6e4a7d21, 0x3c58, 0x4b9f, { 0x8a, 0x02, 0x51, 0xe7, 0xc4, 0x3d, 0x96, 0x1b } }
+
+// A vendor-defined hardware node whose vendor data is the volume's instance number, so that every volume has
+// a distinct device path.
+struct VendorPath {
+    EFI_DEVICE_PATH Header;
+    EFI_GUID        Guid;
+    UINT32          Instance;
+    EFI_DEVICE_PATH End;
+} __attribute__((packed));
+
+struct Volume {
+    EFI_SIMPLE_FILE_SYSTEM_PROTOCOL Protocol;
+    struct VendorPath               DevicePath;
+    char                           *Root;
+};
+
+struct SimFile {
+    EFI_FILE       Protocol;
+    struct Volume *Volume;
+    char          *Path;            // relative to the volume root, '/'-separated, no leading separator
+    int            Descriptor;
+    DIR           *Directory;
+    UINT64         OpenMode;
+    UINT64         Position;
+};
+
+static UINTN OpenFiles;
+
+static EFI_STATUS OpenPath(struct Volume *Volume, const char *Path, UINT64 OpenMode,
+                           EFI_FILE_HANDLE *NewHandle);
+
+// ---- Path handling ------------------------------------------------------------------------------------- //
+
+static void HostPath(struct Volume *Volume, const char *Path, char *Out)
+{
+    snprintf(Out, MAX_FILE_PATH, "%s%s%s", Volume->Root, Path[0] ? "/" : "", Path);
+}
+
+/// Converts a UEFI file name to a normalized, '/'-separated path relative to the volume root. Names that
+/// begin with a backslash are absolute; all others are relative to `Base`. "." and ".." components are
+/// resolved here, and ".." at the root is an error.
+///
+/// @param Base the path of the directory the name is relative to
+/// @param Name the UCS-2 file name passed to EFI_FILE_PROTOCOL.Open()
+/// @param Out  receives the normalized path; at least MAX_FILE_PATH bytes
+///
+/// @return true if the name was valid
+static bool NormalizePath(const char *Base, const CHAR16 *Name, char *Out)
+{
+    size_t length = 0;
+
+    Out[0] = 0;
+    if (Name[0] != L'\\') {
+        length = strlen(Base);
+        if (length >= MAX_FILE_PATH)
+            return false;
+        memcpy(Out, Base, length + 1);
+    }
+
+    while (*Name != 0) {
+        char component[256];
+        size_t n = 0;
+
+        while (*Name == L'\\')
+            Name++;
+        while (*Name != 0 && *Name != L'\\') {
+            CHAR16 c = *Name++;
+            if (n + 3 >= sizeof(component))
+                return false;
+            if (c < 0x80) {
+                component[n++] = (char)c;
+            }
+            else if (c < 0x800) {
+                component[n++] = (char)(0xC0 | (c >> 6));
+                component[n++] = (char)(0x80 | (c & 0x3F));
+            }
+            else {
+                component[n++] = (char)(0xE0 | (c >> 12));
+                component[n++] = (char)(0x80 | ((c >> 6) & 0x3F));
+                component[n++] = (char)(0x80 | (c & 0x3F));
+            }
+        }
+        component[n] = 0;
+
+        if (n == 0 || strcmp(component, ".") == 0)
+            continue;
+        if (strcmp(component, "..") == 0) {
+            if (length == 0)
+                return false;
+            char *slash = strrchr(Out, '/');
+            length = slash ? (size_t)(slash - Out) : 0;
+            Out[length] = 0;
+            continue;
+        }
+        if (strchr(component, '/') != NULL || length + n + 2 >= MAX_FILE_PATH)
+            return false;
+        if (length != 0)
+            Out[length++] = '/';
+        memcpy(Out + length, component, n + 1);
+        length += n;
+    }
+    return true;
+}
+
+/// Rewrites each component of a normalized path to the spelling actually present on the host, matching
+/// case-insensitively where an exact match does not exist. The final component may be missing, in which
+/// case it is left as given so that it can be created.
+///
+/// @return true if every directory component exists
+static bool ResolveCase(struct Volume *Volume, char *Path, bool *Exists)
+{
+    char resolved[MAX_FILE_PATH] = "";
+    char *component = Path;
+
+    *Exists = true;
+    while (*component != 0) {
+        char *next = strchr(component, '/');
+        if (next != NULL)
+            *next = 0;
+
+        char directory[MAX_FILE_PATH], candidate[2 * MAX_FILE_PATH];
+        struct stat st;
+        HostPath(Volume, resolved, directory);
+        snprintf(candidate, sizeof(candidate), "%s/%s", directory, component);
+
+        char match[MAX_FILE_PATH];
+        snprintf(match, sizeof(match), "%s", component);
+        if (lstat(candidate, &st) != 0) {
+            DIR *dir = opendir(directory);
+            bool found = false;
+            struct dirent *entry;
+            while (dir != NULL && (entry = readdir(dir)) != NULL) {
+                if (strcasecmp(entry->d_name, component) == 0) {
+                    strcpy(match, entry->d_name);
+                    found = true;
+                    break;
+                }
+            }
+            if (dir != NULL)
+                closedir(dir);
+            if (!found) {
+                *Exists = false;
+                if (next != NULL)
+                    return false;
+            }
+        }
+
+        size_t used = strlen(resolved), n = strlen(match);
+        if (used + n + 2 > sizeof(resolved))
+            return false;
+        if (used != 0)
+            resolved[used++] = '/';
+        memcpy(resolved + used, match, n + 1);
+        if (next == NULL)
+            break;
+        component = next + 1;
+    }
+    strcpy(Path, resolved);
+    return true;
+}
+
+// ---- File information ---------------------------------------------------------------------------------- //
+
+static void ToEfiTime(time_t Seconds, EFI_TIME *Time)
+{
+    struct tm tm;
+    localtime_r(&Seconds, &tm);
+    *Time = (EFI_TIME){ 0 };
+    Time->Year = (UINT16)(tm.tm_year + 1900);
+    Time->Month = (UINT8)(tm.tm_mon + 1);
+    Time->Day = (UINT8)tm.tm_mday;
+    Time->Hour = (UINT8)tm.tm_hour;
+    Time->Minute = (UINT8)tm.tm_min;
+    Time->Second = (UINT8)tm.tm_sec;
+    Time->TimeZone = 0x07FF;
+}
+
+/// Converts a UTF-8 host name to UCS-2. Characters outside the BMP are replaced with '?'.
+///
+/// @return the number of CHAR16 units written, not including the terminator
+static UINTN ToUcs2(const char *Name, CHAR16 *Out)
+{
+    const unsigned char *s = (const unsigned char *)Name;
+    UINTN n = 0;
+    while (*s != 0) {
+        UINT32 c = *s++;
+        if (c >= 0xF0) {
+            s += 3;
+            c = L'?';
+        }
+        else if (c >= 0xE0) {
+            c = ((c & 0x0F) << 12) | ((s[0] & 0x3F) << 6) | (s[1] & 0x3F);
+            s += 2;
+        }
+        else if (c >= 0xC0) {
+            c = ((c & 0x1F) << 6) | (s[0] & 0x3F);
+            s += 1;
+        }
+        if (Out != NULL)
+            Out[n] = (CHAR16)c;
+        n++;
+    }
+    if (Out != NULL)
+        Out[n] = 0;
+    return n;
+}
+
+/// Builds an EFI_FILE_INFO record describing a host file.
+///
+/// @param HostName   the full host path, for stat()
+/// @param Name       the name to report in the record
+/// @param BufferSize on input, the size of Buffer; on output, the size of the record
+/// @param Buffer     receives the record
+///
+/// @return EFI_SUCCESS, EFI_BUFFER_TOO_SMALL, or EFI_DEVICE_ERROR if the file cannot be examined
+static EFI_STATUS FillFileInfo(const char *HostName, const char *Name, UINTN *BufferSize, VOID *Buffer)
+{
+    struct stat st;
+    if (stat(HostName, &st) != 0)
+        return EFI_DEVICE_ERROR;
+
+    UINTN size = SIZE_OF_EFI_FILE_INFO + (ToUcs2(Name, NULL) + 1) * sizeof(CHAR16);
+    if (*BufferSize < size) {
+        *BufferSize = size;
+        return EFI_BUFFER_TOO_SMALL;
+    }
+    if (Buffer == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    EFI_FILE_INFO *info = Buffer;
+    info->Size = size;
+    info->FileSize = S_ISDIR(st.st_mode) ? 0 : (UINT64)st.st_size;
+    info->PhysicalSize = (UINT64)st.st_blocks * 512;
+    ToEfiTime(st.st_ctime, &info->CreateTime);
+    ToEfiTime(st.st_atime, &info->LastAccessTime);
+    ToEfiTime(st.st_mtime, &info->ModificationTime);
+    info->Attribute = 0;
+    if (S_ISDIR(st.st_mode))
+        info->Attribute |= EFI_FILE_DIRECTORY;
+    if (access(HostName, W_OK) != 0)
+        info->Attribute |= EFI_FILE_READ_ONLY;
+    if (Name[0] == '.' && strcmp(Name, ".") != 0 && strcmp(Name, "..") != 0)
+        info->Attribute |= EFI_FILE_HIDDEN;
+    ToUcs2(Name, info->FileName);
+
+    *BufferSize = size;
+    return EFI_SUCCESS;
+}
+
+// ---- EFI_FILE_PROTOCOL --------------------------------------------------------------------------------- //
+
+static EFI_STATUS EFIAPI FileOpen(EFI_FILE_HANDLE File, EFI_FILE_HANDLE *NewHandle, CHAR16 *FileName,
+                                  UINT64 OpenMode, UINT64 Attributes)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    char path[MAX_FILE_PATH], host[MAX_FILE_PATH];
+    bool exists;
+
+    if (self == NULL || NewHandle == NULL || FileName == NULL)
+        return EFI_INVALID_PARAMETER;
+    if (OpenMode != EFI_FILE_MODE_READ && OpenMode != (EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE) &&
+        OpenMode != (EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_CREATE))
+        return EFI_INVALID_PARAMETER;
+
+    // Names relative to a file (rather than a directory) are taken relative to the directory containing it.
+    char base[MAX_FILE_PATH];
+    snprintf(base, sizeof(base), "%s", self->Path);
+    if (self->Directory == NULL) {
+        char *slash = strrchr(base, '/');
+        *(slash ? slash : base) = 0;
+    }
+
+    if (!NormalizePath(base, FileName, path) || !ResolveCase(self->Volume, path, &exists))
+        return EFI_NOT_FOUND;
+
+    if (!exists) {
+        if (!(OpenMode & EFI_FILE_MODE_CREATE))
+            return EFI_NOT_FOUND;
+        HostPath(self->Volume, path, host);
+        if (Attributes & EFI_FILE_DIRECTORY) {
+            if (mkdir(host, 0755) != 0)
+                return errno == ENOSPC ? EFI_VOLUME_FULL : EFI_WRITE_PROTECTED;
+        }
+        else {
+            int fd = open(host, O_CREAT | O_EXCL | O_WRONLY, (Attributes & EFI_FILE_READ_ONLY) ? 0444 : 0644);
+            if (fd < 0)
+                return errno == ENOSPC ? EFI_VOLUME_FULL : EFI_WRITE_PROTECTED;
+            close(fd);
+        }
+    }
+    return OpenPath(self->Volume, path, OpenMode, NewHandle);
+}
+
+static EFI_STATUS EFIAPI FileClose(EFI_FILE_HANDLE File)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    if (self == NULL)
+        return EFI_INVALID_PARAMETER;
+    if (self->Directory != NULL)
+        closedir(self->Directory);
+    if (self->Descriptor >= 0)
+        close(self->Descriptor);
+    free(self->Path);
+    free(self);
+    OpenFiles--;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI FileDelete(EFI_FILE_HANDLE File)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    char host[MAX_FILE_PATH];
+    int result;
+
+    if (self == NULL)
+        return EFI_INVALID_PARAMETER;
+    HostPath(self->Volume, self->Path, host);
+    bool directory = self->Directory != NULL;
+    bool writable = (self->OpenMode & EFI_FILE_MODE_WRITE) != 0 && self->Path[0] != 0;
+    FileClose(File);
+
+    if (!writable)
+        return EFI_WARN_DELETE_FAILURE;
+    result = directory ? rmdir(host) : unlink(host);
+    return result == 0 ? EFI_SUCCESS : EFI_WARN_DELETE_FAILURE;
+}
+
+static EFI_STATUS EFIAPI FileRead(EFI_FILE_HANDLE File, UINTN *BufferSize, VOID *Buffer)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    if (self == NULL || BufferSize == NULL || (*BufferSize != 0 && Buffer == NULL))
+        return EFI_INVALID_PARAMETER;
+
+    if (self->Directory != NULL) {
+        // Each read returns one EFI_FILE_INFO; a zero-length read marks the end of the directory.
+        struct dirent *entry;
+        long mark;
+        do {
+            mark = telldir(self->Directory);
+            entry = readdir(self->Directory);
+        } while (entry != NULL && (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0));
+        if (entry == NULL) {
+            *BufferSize = 0;
+            return EFI_SUCCESS;
+        }
+
+        char host[MAX_FILE_PATH + 256], directory[MAX_FILE_PATH];
+        HostPath(self->Volume, self->Path, directory);
+        snprintf(host, sizeof(host), "%s/%s", directory, entry->d_name);
+        EFI_STATUS status = FillFileInfo(host, entry->d_name, BufferSize, Buffer);
+        if (status == EFI_BUFFER_TOO_SMALL)
+            seekdir(self->Directory, mark);
+        return status;
+    }
+
+    struct stat st;
+    if (fstat(self->Descriptor, &st) != 0)
+        return EFI_DEVICE_ERROR;
+    if (self->Position > (UINT64)st.st_size)
+        return EFI_DEVICE_ERROR;
+
+    UINTN total = 0;
+    while (total < *BufferSize) {
+        ssize_t n = pread(self->Descriptor, (UINT8 *)Buffer + total, *BufferSize - total,
+                          (off_t)(self->Position + total));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            return EFI_DEVICE_ERROR;
+        if (n == 0)
+            break;
+        total += (UINTN)n;
+    }
+    self->Position += total;
+    *BufferSize = total;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI FileWrite(EFI_FILE_HANDLE File, UINTN *BufferSize, VOID *Buffer)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    if (self == NULL || BufferSize == NULL || (*BufferSize != 0 && Buffer == NULL))
+        return EFI_INVALID_PARAMETER;
+    if (self->Directory != NULL)
+        return EFI_UNSUPPORTED;
+    if (!(self->OpenMode & EFI_FILE_MODE_WRITE))
+        return EFI_ACCESS_DENIED;
+
+    UINTN total = 0;
+    while (total < *BufferSize) {
+        ssize_t n = pwrite(self->Descriptor, (UINT8 *)Buffer + total, *BufferSize - total,
+                           (off_t)(self->Position + total));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            *BufferSize = total;
+            self->Position += total;
+            return errno == ENOSPC ? EFI_VOLUME_FULL : EFI_DEVICE_ERROR;
+        }
+        total += (UINTN)n;
+    }
+    self->Position += total;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI FileGetPosition(EFI_FILE_HANDLE File, UINT64 *Position)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    if (self == NULL || Position == NULL)
+        return EFI_INVALID_PARAMETER;
+    if (self->Directory != NULL)
+        return EFI_UNSUPPORTED;
+    *Position = self->Position;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI FileSetPosition(EFI_FILE_HANDLE File, UINT64 Position)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    if (self == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    if (self->Directory != NULL) {
+        // Only rewinding is defined for directories.
+        if (Position != 0)
+            return EFI_UNSUPPORTED;
+        rewinddir(self->Directory);
+        return EFI_SUCCESS;
+    }
+
+    if (Position == 0xFFFFFFFFFFFFFFFFULL) {
+        struct stat st;
+        if (fstat(self->Descriptor, &st) != 0)
+            return EFI_DEVICE_ERROR;
+        Position = (UINT64)st.st_size;
+    }
+    self->Position = Position;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI FileGetInfo(EFI_FILE_HANDLE File, EFI_GUID *InformationType, UINTN *BufferSize,
+                                     VOID *Buffer)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    EFI_GUID fileInfo = EFI_FILE_INFO_ID;
+    char host[MAX_FILE_PATH];
+
+    if (self == NULL || InformationType == NULL || BufferSize == NULL)
+        return EFI_INVALID_PARAMETER;
+    if (memcmp(InformationType, &fileInfo, sizeof(EFI_GUID)) != 0)
+        return EFI_UNSUPPORTED;
+
+    HostPath(self->Volume, self->Path, host);
+    const char *slash = strrchr(self->Path, '/');
+    const char *name = self->Path[0] == 0 ? "\\" : slash ? slash + 1 : self->Path;
+    return FillFileInfo(host, name, BufferSize, Buffer);
+}
+
+static EFI_STATUS EFIAPI FileSetInfo(EFI_FILE_HANDLE File, EFI_GUID *InformationType, UINTN BufferSize,
+                                     VOID *Buffer)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    EFI_GUID fileInfo = EFI_FILE_INFO_ID;
+
+    if (self == NULL || InformationType == NULL || Buffer == NULL)
+        return EFI_INVALID_PARAMETER;
+    if (memcmp(InformationType, &fileInfo, sizeof(EFI_GUID)) != 0)
+        return EFI_UNSUPPORTED;
+    if (BufferSize < SIZE_OF_EFI_FILE_INFO)
+        return EFI_BAD_BUFFER_SIZE;
+    if (!(self->OpenMode & EFI_FILE_MODE_WRITE))
+        return EFI_ACCESS_DENIED;
+
+    // Only resizing is supported; renames and attribute changes are not needed by the loader.
+    EFI_FILE_INFO *info = Buffer;
+    if (self->Directory != NULL)
+        return EFI_UNSUPPORTED;
+    if (ftruncate(self->Descriptor, (off_t)info->FileSize) != 0)
+        return EFI_DEVICE_ERROR;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI FileFlush(EFI_FILE_HANDLE File)
+{
+    struct SimFile *self = (struct SimFile *)File;
+    if (self == NULL)
+        return EFI_INVALID_PARAMETER;
+    if (self->Directory == NULL && (self->OpenMode & EFI_FILE_MODE_WRITE) && fsync(self->Descriptor) != 0)
+        return EFI_DEVICE_ERROR;
+    return EFI_SUCCESS;
+}
+
+/// Opens a handle on an existing, normalized and case-resolved path.
+static EFI_STATUS OpenPath(struct Volume *Volume, const char *Path, UINT64 OpenMode,
+                           EFI_FILE_HANDLE *NewHandle)
+{
+    char host[MAX_FILE_PATH];
+    struct stat st;
+
+    HostPath(Volume, Path, host);
+    if (stat(host, &st) != 0)
+        return EFI_NOT_FOUND;
+
+    struct SimFile *file = calloc(1, sizeof(struct SimFile));
+    if (file == NULL)
+        return EFI_OUT_OF_RESOURCES;
+    file->Volume = Volume;
+    file->Path = strdup(Path);
+    file->OpenMode = OpenMode;
+    file->Descriptor = -1;
+
+    if (S_ISDIR(st.st_mode)) {
+        file->Directory = opendir(host);
+        if (file->Directory == NULL) {
+            free(file->Path);
+            free(file);
+            return EFI_ACCESS_DENIED;
+        }
+    }
+    else {
+        file->Descriptor = open(host, (OpenMode & EFI_FILE_MODE_WRITE) ? O_RDWR : O_RDONLY);
+        if (file->Descriptor < 0) {
+            free(file->Path);
+            free(file);
+            return (errno == EACCES || errno == EROFS) ? EFI_WRITE_PROTECTED : EFI_DEVICE_ERROR;
+        }
+    }
+
+    file->Protocol.Revision = FILE_PROTOCOL_REVISION;
+    file->Protocol.Open = FileOpen;
+    file->Protocol.Close = FileClose;
+    file->Protocol.Delete = FileDelete;
+    file->Protocol.Read = FileRead;
+    file->Protocol.Write = FileWrite;
+    file->Protocol.GetPosition = FileGetPosition;
+    file->Protocol.SetPosition = FileSetPosition;
+    file->Protocol.GetInfo = FileGetInfo;
+    file->Protocol.SetInfo = FileSetInfo;
+    file->Protocol.Flush = FileFlush;
+
+    OpenFiles++;
+    *NewHandle = &file->Protocol;
+    return EFI_SUCCESS;
+}
+
+// ---- EFI_SIMPLE_FILE_SYSTEM_PROTOCOL ------------------------------------------------------------------- //
+
+static EFI_STATUS EFIAPI OpenVolume(EFI_SIMPLE_FILE_SYSTEM_PROTOCOL *This, EFI_FILE_HANDLE *Root)
+{
+    if (This == NULL || Root == NULL)
+        return EFI_INVALID_PARAMETER;
+    return OpenPath((struct Volume *)This, "", EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE, Root);
+}
+
+/// Returns the number of file handles the image has opened and not yet closed.
+UINTN OpenFileCount(void)
+{
+    return OpenFiles;
+}
+
+/// Creates a volume backed by a host directory and installs it on a new handle, together with a vendor
+/// device path so that the handle can be found again with LocateDevicePath().
+///
+/// @param BS   the boot services table to install the protocols with
+/// @param Root the host directory to expose as the volume's root
+///
+/// @return the new device handle, or NULL if the directory cannot be used
+EFI_HANDLE CreateVolume(EFI_BOOT_SERVICES *BS, const char *Root)
+{
+    EFI_GUID fileSystem = EFI_SIMPLE_FILE_SYSTEM_PROTOCOL_GUID;
+    EFI_GUID devicePath = EFI_DEVICE_PATH_PROTOCOL_GUID;
+    EFI_GUID vendor = SIM_VOLUME_GUID;
+    static UINT32 instances;
+    EFI_HANDLE handle = NULL;
+    struct stat st;
+
+    if (stat(Root, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        fprintf(stderr, "uefisim: %s is not a directory\n", Root);
+        return NULL;
+    }
+
+    struct Volume *volume = calloc(1, sizeof(struct Volume));
+    volume->Root = realpath(Root, NULL);
+    volume->Protocol.Revision = SIMPLE_FILE_SYSTEM_REVISION;
+    volume->Protocol.OpenVolume = OpenVolume;
+
+    volume->DevicePath.Header.Type = HARDWARE_DEVICE_PATH;
+    volume->DevicePath.Header.SubType = HW_VENDOR_DP;
+    volume->DevicePath.Header.Length[0] = sizeof(EFI_DEVICE_PATH) + sizeof(EFI_GUID) + sizeof(UINT32);
+    volume->DevicePath.Guid = vendor;
+    volume->DevicePath.Instance = instances++;
+    volume->DevicePath.End.Type = END_DEVICE_PATH_TYPE;
+    volume->DevicePath.End.SubType = END_ENTIRE_DEVICE_PATH_SUBTYPE;
+    volume->DevicePath.End.Length[0] = END_DEVICE_PATH_LENGTH;
+
+    if (EFI_ERROR(BS->InstallProtocolInterface(&handle, &fileSystem, EFI_NATIVE_INTERFACE,
+                                               &volume->Protocol)) ||
+        EFI_ERROR(BS->InstallProtocolInterface(&handle, &devicePath, EFI_NATIVE_INTERFACE,
+                                               &volume->DevicePath)))
+        return NULL;
+    return handle;
+}
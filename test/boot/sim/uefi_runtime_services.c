@@ -0,0 +1,344 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : UEFI Runtime Services, UEFI Simulator, UEFI Bootloader Test Suite                          //
+// Filename    : uefi_runtime_services.c                                                                    //
+// Description : Implements the simulated EFI_RUNTIME_SERVICES table: time, system reset, and a variable    //
+//               store whose non-volatile variables may be persisted to a host file so that state such as   //
+//               the kernel location cache survives between runs.                                           //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "uefi_sim.h"
+
+#define NVRAM_MAGIC         0x564E4853      // 'SHNV'
+#define NVRAM_CAPACITY      (64 * 1024)
+
+struct Variable {
+    CHAR16          *Name;
+    EFI_GUID         Vendor;
+    UINT32           Attributes;
+    UINTN            DataSize;
+    UINT8           *Data;
+    struct Variable *Next;
+};
+
+static struct Variable *Variables;
+static const char      *NvramPath;
+static UINTN            Writes;
+
+static UINTN NameLength(const CHAR16 *Name)
+{
+    UINTN length = 0;
+    while (Name[length] != 0)
+        length++;
+    return length;
+}
+
+static struct Variable *FindVariable(const CHAR16 *Name, const EFI_GUID *Vendor)
+{
+    for (struct Variable *v = Variables; v != NULL; v = v->Next) {
+        UINTN length = NameLength(v->Name);
+        if (memcmp(&v->Vendor, Vendor, sizeof(EFI_GUID)) == 0 && NameLength(Name) == length &&
+            memcmp(v->Name, Name, length * sizeof(CHAR16)) == 0)
+            return v;
+    }
+    return NULL;
+}
+
+static UINTN NonVolatileUsage(void)
+{
+    UINTN total = 0;
+    for (struct Variable *v = Variables; v != NULL; v = v->Next) {
+        if (v->Attributes & EFI_VARIABLE_NON_VOLATILE)
+            total += (NameLength(v->Name) + 1) * sizeof(CHAR16) + v->DataSize;
+    }
+    return total;
+}
+
+// ---- Persistence --------------------------------------------------------------------------------------- //
+
+/// Writes every non-volatile variable to the NVRAM file. The file is replaced atomically so that an
+/// interrupted run cannot leave it torn.
+static void SaveVariables(void)
+{
+    char temporary[4096];
+    if (NvramPath == NULL)
+        return;
+    snprintf(temporary, sizeof(temporary), "%s.tmp", NvramPath);
+
+    FILE *file = fopen(temporary, "wb");
+    if (file == NULL) {
+        perror("uefisim: unable to write NVRAM file");
+        return;
+    }
+
+    UINT32 magic = NVRAM_MAGIC;
+    fwrite(&magic, sizeof(magic), 1, file);
+    for (struct Variable *v = Variables; v != NULL; v = v->Next) {
+        if (!(v->Attributes & EFI_VARIABLE_NON_VOLATILE))
+            continue;
+        UINT32 nameBytes = (UINT32)((NameLength(v->Name) + 1) * sizeof(CHAR16));
+        UINT32 dataSize = (UINT32)v->DataSize;
+        fwrite(&v->Vendor, sizeof(EFI_GUID), 1, file);
+        fwrite(&v->Attributes, sizeof(UINT32), 1, file);
+        fwrite(&nameBytes, sizeof(UINT32), 1, file);
+        fwrite(&dataSize, sizeof(UINT32), 1, file);
+        fwrite(v->Name, 1, nameBytes, file);
+        fwrite(v->Data, 1, dataSize, file);
+    }
+
+    if (fclose(file) != 0 || rename(temporary, NvramPath) != 0)
+        perror("uefisim: unable to write NVRAM file");
+}
+
+static void LoadVariables(void)
+{
+    FILE *file = fopen(NvramPath, "rb");
+    UINT32 magic;
+    if (file == NULL)
+        return;
+    if (fread(&magic, sizeof(magic), 1, file) != 1 || magic != NVRAM_MAGIC) {
+        fprintf(stderr, "uefisim: ignoring malformed NVRAM file %s\n", NvramPath);
+        fclose(file);
+        return;
+    }
+
+    for (;;) {
+        EFI_GUID vendor;
+        UINT32 attributes, nameBytes, dataSize;
+        if (fread(&vendor, sizeof(EFI_GUID), 1, file) != 1 ||
+            fread(&attributes, sizeof(UINT32), 1, file) != 1 ||
+            fread(&nameBytes, sizeof(UINT32), 1, file) != 1 || fread(&dataSize, sizeof(UINT32), 1, file) != 1)
+            break;
+        if (nameBytes < sizeof(CHAR16) || nameBytes > NVRAM_CAPACITY || dataSize > NVRAM_CAPACITY)
+            break;
+
+        struct Variable *v = calloc(1, sizeof(struct Variable));
+        v->Name = malloc(nameBytes);
+        v->Data = malloc(dataSize ? dataSize : 1);
+        if (fread(v->Name, 1, nameBytes, file) != nameBytes ||
+            fread(v->Data, 1, dataSize, file) != dataSize) {
+            free(v->Name);
+            free(v->Data);
+            free(v);
+            break;
+        }
+        v->Name[nameBytes / sizeof(CHAR16) - 1] = 0;
+        v->Vendor = vendor;
+        v->Attributes = attributes;
+        v->DataSize = dataSize;
+        v->Next = Variables;
+        Variables = v;
+    }
+    fclose(file);
+}
+
+// ---- Variable services --------------------------------------------------------------------------------- //
+
+static EFI_STATUS EFIAPI SimGetVariable(CHAR16 *VariableName, EFI_GUID *VendorGuid, UINT32 *Attributes,
+                                        UINTN *DataSize, VOID *Data)
+{
+    if (VariableName == NULL || VendorGuid == NULL || DataSize == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    struct Variable *v = FindVariable(VariableName, VendorGuid);
+    if (v == NULL)
+        return EFI_NOT_FOUND;
+    if (*DataSize < v->DataSize) {
+        *DataSize = v->DataSize;
+        return EFI_BUFFER_TOO_SMALL;
+    }
+    if (Data == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    memcpy(Data, v->Data, v->DataSize);
+    *DataSize = v->DataSize;
+    if (Attributes != NULL)
+        *Attributes = v->Attributes;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimGetNextVariableName(UINTN *VariableNameSize, CHAR16 *VariableName,
+                                                EFI_GUID *VendorGuid)
+{
+    if (VariableNameSize == NULL || VariableName == NULL || VendorGuid == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    struct Variable *next = Variables;
+    if (VariableName[0] != 0) {
+        struct Variable *current = FindVariable(VariableName, VendorGuid);
+        if (current == NULL)
+            return EFI_INVALID_PARAMETER;
+        next = current->Next;
+    }
+    if (next == NULL)
+        return EFI_NOT_FOUND;
+
+    UINTN bytes = (NameLength(next->Name) + 1) * sizeof(CHAR16);
+    if (*VariableNameSize < bytes) {
+        *VariableNameSize = bytes;
+        return EFI_BUFFER_TOO_SMALL;
+    }
+    memcpy(VariableName, next->Name, bytes);
+    *VendorGuid = next->Vendor;
+    *VariableNameSize = bytes;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI SimSetVariable(CHAR16 *VariableName, EFI_GUID *VendorGuid, UINT32 Attributes,
+                                        UINTN DataSize, VOID *Data)
+{
+    if (VariableName == NULL || VariableName[0] == 0 || VendorGuid == NULL)
+        return EFI_INVALID_PARAMETER;
+    if ((Attributes & EFI_VARIABLE_RUNTIME_ACCESS) && !(Attributes & EFI_VARIABLE_BOOTSERVICE_ACCESS))
+        return EFI_INVALID_PARAMETER;
+    if (DataSize != 0 && Data == NULL)
+        return EFI_INVALID_PARAMETER;
+
+    struct Variable *v = FindVariable(VariableName, VendorGuid);
+    bool persist = ((v != NULL && (v->Attributes & EFI_VARIABLE_NON_VOLATILE)) ||
+                    (Attributes & EFI_VARIABLE_NON_VOLATILE));
+
+    // A zero size or zero attributes deletes the variable.
+    if (DataSize == 0 || Attributes == 0) {
+        if (v == NULL)
+            return EFI_NOT_FOUND;
+        for (struct Variable **link = &Variables; *link != NULL; link = &(*link)->Next) {
+            if (*link == v) {
+                *link = v->Next;
+                break;
+            }
+        }
+        free(v->Name);
+        free(v->Data);
+        free(v);
+    }
+    else {
+        if (v != NULL && v->Attributes != Attributes)
+            return EFI_INVALID_PARAMETER;
+        if ((Attributes & EFI_VARIABLE_NON_VOLATILE) &&
+            NonVolatileUsage() - (v ? v->DataSize : 0) + DataSize > NVRAM_CAPACITY)
+            return EFI_OUT_OF_RESOURCES;
+
+        UINT8 *data = malloc(DataSize);
+        if (data == NULL)
+            return EFI_OUT_OF_RESOURCES;
+        memcpy(data, Data, DataSize);
+
+        if (v == NULL) {
+            UINTN bytes = (NameLength(VariableName) + 1) * sizeof(CHAR16);
+            v = calloc(1, sizeof(struct Variable));
+            v->Name = malloc(bytes);
+            memcpy(v->Name, VariableName, bytes);
+            v->Vendor = *VendorGuid;
+            v->Attributes = Attributes;
+            v->Next = Variables;
+            Variables = v;
+        }
+        free(v->Data);
+        v->Data = data;
+        v->DataSize = DataSize;
+    }
+
+    if (persist) {
+        Writes++;
+        SaveVariables();
+    }
+    return EFI_SUCCESS;
+}
+
+/// Returns the number of writes made to non-volatile variables, i.e. the NVRAM flash traffic the image
+/// would have generated.
+UINTN VariableWrites(void)
+{
+    return Writes;
+}
+
+// ---- Time and reset ------------------------------------------------------------------------------------ //
+
+static EFI_STATUS EFIAPI SimGetTime(EFI_TIME *Time, EFI_TIME_CAPABILITIES *Capabilities)
+{
+    struct timespec ts;
+    struct tm tm;
+
+    if (Time == NULL)
+        return EFI_INVALID_PARAMETER;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    localtime_r(&ts.tv_sec, &tm);
+
+    *Time = (EFI_TIME){ 0 };
+    Time->Year = (UINT16)(tm.tm_year + 1900);
+    Time->Month = (UINT8)(tm.tm_mon + 1);
+    Time->Day = (UINT8)tm.tm_mday;
+    Time->Hour = (UINT8)tm.tm_hour;
+    Time->Minute = (UINT8)tm.tm_min;
+    Time->Second = (UINT8)tm.tm_sec;
+    Time->Nanosecond = (UINT32)ts.tv_nsec;
+    Time->TimeZone = 0x07FF;        // EFI_UNSPECIFIED_TIMEZONE
+
+    if (Capabilities != NULL) {
+        Capabilities->Resolution = 1;
+        Capabilities->Accuracy = 50000000;
+        Capabilities->SetsToZero = FALSE;
+    }
+    return EFI_SUCCESS;
+}
+
+static VOID EFIAPI SimResetSystem(EFI_RESET_TYPE ResetType, EFI_STATUS ResetStatus, UINTN DataSize,
+                                  VOID *ResetData)
+{
+    (void)DataSize;
+    (void)ResetData;
+    fprintf(stderr, "uefisim: ResetSystem(%s, 0x%lx)\n",
+            ResetType == EfiResetShutdown ? "shutdown" : ResetType == EfiResetWarm ? "warm" : "cold",
+            (unsigned long)ResetStatus);
+    fflush(stdout);
+    exit(EFI_ERROR(ResetStatus) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/// Fills in the runtime services table and loads any persisted variables.
+///
+/// @param RT   the table to initialize
+/// @param Path the host file in which non-volatile variables are kept, or `NULL` to keep them in memory
+void InitializeRuntimeServices(EFI_RUNTIME_SERVICES *RT, const char *Path)
+{
+    memset(RT, 0, sizeof(EFI_RUNTIME_SERVICES));
+    RT->Hdr.Signature = EFI_RUNTIME_SERVICES_SIGNATURE;
+    RT->Hdr.Revision = EFI_SPECIFICATION_VERSION;
+    RT->Hdr.HeaderSize = sizeof(EFI_RUNTIME_SERVICES);
+
+    RT->GetTime = SimGetTime;
+    RT->GetVariable = SimGetVariable;
+    RT->GetNextVariableName = SimGetNextVariableName;
+    RT->SetVariable = SimSetVariable;
+    RT->ResetSystem = SimResetSystem;
+    RT->Hdr.CRC32 = CalculateTableCrc(&RT->Hdr);
+
+    NvramPath = Path;
+    if (NvramPath != NULL)
+        LoadVariables();
+}
@@ -0,0 +1,55 @@
+// -------------------------------------------------------------------------------------------------------- //
+// Title       : UEFI Simulator (Header), UEFI Simulator, UEFI Bootloader Test Suite                        //
+// Filename    : uefi_sim.h                                                                                 //
+// Description : Provides the header file shared by the components of the host-side UEFI simulator, which   //
+//               builds an EFI_SYSTEM_TABLE out of host facilities so that the bootloader can be linked and //
+//               run as an ordinary process.                                                                //
+//                                                                                                          //
+// Project     : Shasta Microkernel                                                                         //
+// Main Author : Elijah Creed Fedele <ecfedele@outlook.com>                                                 //
+// Created     : October 19, 2026                                                                           //
+// Modified    : October 19, 2026                                                                           //
+// Version     : 0.0.0                                                                                      //
+// License     : GNU General Public License (GPL) version 3.0                                               //
+// Copyright   : (C) 2023- Elijah Creed Fedele                                                              //
+// -------------------------------------------------------------------------------------------------------- //
+// This file is part of the Shasta microkernel project (https://github.com/ecfedele/shasta).                //
+// Copyright (c) 2023- Elijah Creed Fedele.                                                                 //
+//                                                                                                          //
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU       //
+// General Public License as published by the Free Software Foundation, version 3.                          //
+//                                                                                                          //
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even   //
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  //
+// License for more details.                                                                                //
+//                                                                                                          //
+// You should have received a copy of the GNU General Public License along with this program. If not, see   //
+//     <http://www.gnu.org/licenses/>.                                                                      //
+// -------------------------------------------------------------------------------------------------------- //
+
+#ifndef UEFI_SIM_H_INCLUDED
+#define UEFI_SIM_H_INCLUDED
+
+#include <efi.h>
+#include <stdbool.h>
+
+#define SIM_DESCRIPTOR_SIZE     48      // as reported by OVMF; callers must not assume sizeof(descriptor)
+#define SIM_MAX_PROTOCOLS       8
+
+extern bool SimQuiet;
+
+UINT64      MonotonicNanoseconds        (void);
+UINT32      CalculateTableCrc           (EFI_TABLE_HEADER *Hdr);
+void        InitializeBootServices      (EFI_BOOT_SERVICES *BS, UINT64 ConventionalBytes);
+void        BeginImage                  (void);
+void        ResetBootServices           (void);
+bool        BootServicesExited          (void);
+UINTN       ReportAllocations           (bool Release);
+void        InitializeRuntimeServices   (EFI_RUNTIME_SERVICES *RT, const char *NvramPath);
+UINTN       VariableWrites              (void);
+void        InitializeConsole           (EFI_SYSTEM_TABLE *ST, const char *Keys);
+void        ResetConsole                (const char *Keys);
+EFI_HANDLE  CreateVolume                (EFI_BOOT_SERVICES *BS, const char *Root);
+UINTN       OpenFileCount               (void);
+
+#endif // UEFI_SIM_H_INCLUDED